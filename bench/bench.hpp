@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A minimal, dependency-free micro-benchmark harness
+ *
+ * @code
+ * BRIGADIER_BENCHMARK(readInt)
+ * {
+ *     while (state.keepRunning())
+ *         bench::doNotOptimize(parse());
+ * }
+ * @endcode
+ */
+namespace bench {
+class State {
+public:
+    explicit State(size_t iterations):
+        _iterations(iterations),
+        _remaining(iterations)
+    {
+    }
+
+    /**
+     * @brief Must be the condition of the measured loop
+     *
+     * @return bool
+     */
+    bool keepRunning()
+    {
+        if (_remaining == _iterations)
+            _start = std::chrono::steady_clock::now();
+        if (_remaining-- != 0)
+            return true;
+        _elapsed = std::chrono::steady_clock::now() - _start;
+        return false;
+    }
+
+    size_t iterations() const { return _iterations; }
+    std::chrono::nanoseconds elapsed() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(_elapsed); }
+
+private:
+    size_t _iterations;
+    size_t _remaining;
+    std::chrono::steady_clock::time_point _start;
+    std::chrono::steady_clock::duration _elapsed {};
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State &)> function;
+};
+
+inline std::vector<Benchmark> &registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registration {
+    Registration(std::string name, std::function<void(State &)> function) { registry().push_back({std::move(name), std::move(function)}); }
+};
+
+/**
+ * @brief Prevent the compiler from optimizing value away
+ */
+template<typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace bench
+
+#define BRIGADIER_BENCHMARK_CONCAT_(a, b) a##b
+#define BRIGADIER_BENCHMARK_CONCAT(a, b) BRIGADIER_BENCHMARK_CONCAT_(a, b)
+
+#define BRIGADIER_BENCHMARK(name)                                                                                                \
+    static void BRIGADIER_BENCHMARK_CONCAT(bench_, name)(bench::State & state);                                                  \
+    static bench::Registration BRIGADIER_BENCHMARK_CONCAT(registration_, name)(#name, BRIGADIER_BENCHMARK_CONCAT(bench_, name)); \
+    static void BRIGADIER_BENCHMARK_CONCAT(bench_, name)(bench::State & state)
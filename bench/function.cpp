@@ -0,0 +1,68 @@
+#include "bench.hpp"
+#include <brigadier/Function.hpp>
+#include <functional>
+#include <string>
+
+/**
+ * Calling a callback taking a parsed string by value, the string is moved in
+ */
+static const std::string ARGUMENT = "a string too long for the small string optimization";
+
+template<typename F>
+static void invokeWithString(bench::State &state, const F &callback)
+{
+    while (state.keepRunning()) {
+        std::string argument = ARGUMENT;
+        callback(std::move(argument));
+    }
+}
+
+BRIGADIER_BENCHMARK(callback_std_function_string)
+{
+    size_t total = 0;
+    std::function<void(std::string)> callback = [&total](std::string value) { total += value.size(); };
+    invokeWithString(state, callback);
+    bench::doNotOptimize(total);
+}
+
+BRIGADIER_BENCHMARK(callback_function_string)
+{
+    size_t total = 0;
+    brigadier::Function<void(std::string)> callback = [&total](std::string value) { total += value.size(); };
+    invokeWithString(state, callback);
+    bench::doNotOptimize(total);
+}
+
+BRIGADIER_BENCHMARK(callback_std_function_large_capture)
+{
+    size_t total = 0;
+    std::function<void(std::string)> callback = [&total, a = ARGUMENT.size(), b = size_t(1), c = size_t(2)](std::string value) { total += value.size() + a + b + c; };
+    invokeWithString(state, callback);
+    bench::doNotOptimize(total);
+}
+
+BRIGADIER_BENCHMARK(callback_function_large_capture)
+{
+    size_t total = 0;
+    brigadier::Function<void(std::string)> callback = [&total, a = ARGUMENT.size(), b = size_t(1), c = size_t(2)](std::string value) { total += value.size() + a + b + c; };
+    invokeWithString(state, callback);
+    bench::doNotOptimize(total);
+}
+
+BRIGADIER_BENCHMARK(callback_std_function_int)
+{
+    int total = 0;
+    std::function<void(int)> callback = [&total](int value) { total += value; };
+    for (int i = 0; state.keepRunning(); ++i)
+        callback(i);
+    bench::doNotOptimize(total);
+}
+
+BRIGADIER_BENCHMARK(callback_function_int)
+{
+    int total = 0;
+    brigadier::Function<void(int)> callback = [&total](int value) { total += value; };
+    for (int i = 0; state.keepRunning(); ++i)
+        callback(int(i));
+    bench::doNotOptimize(total);
+}
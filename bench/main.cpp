@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include <cstdio>
+#include <string_view>
+
+/**
+ * @brief Run every registered benchmark whose name contains the filter argument, if any
+ *
+ * `--json` prints `{"benchmarks": [{"name", "ns_per_op", "iterations"}, ...]}` instead of a table.
+ */
+int main(int argc, char **argv)
+{
+    using namespace std::chrono_literals;
+
+    std::string_view filter;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--json")
+            json = true;
+        else
+            filter = argv[i];
+    }
+
+    if (json)
+        std::printf("{\"benchmarks\": [");
+    else
+        std::printf("%-48s %14s %12s\n", "benchmark", "ns/op", "iterations");
+    const char *separator = "\n";
+    for (auto &benchmark : bench::registry()) {
+        if (benchmark.name.find(filter) == std::string::npos)
+            continue;
+        size_t iterations = 1;
+        while (true) {
+            bench::State state(iterations);
+            benchmark.function(state);
+            if (state.elapsed() >= 200ms || iterations >= (size_t(1) << 32)) {
+                auto nsPerOp = double(state.elapsed().count()) / double(iterations);
+                if (json)
+                    std::printf("%s  {\"name\": \"%s\", \"ns_per_op\": %.2f, \"iterations\": %zu}", separator, benchmark.name.c_str(), nsPerOp, iterations);
+                else
+                    std::printf("%-48s %14.2f %12zu\n", benchmark.name.c_str(), nsPerOp, iterations);
+                separator = ",\n";
+                std::fflush(stdout);
+                break;
+            }
+            iterations *= state.elapsed() < 20ms ? 10 : 2;
+        }
+    }
+    if (json)
+        std::printf("\n]}\n");
+    return 0;
+}
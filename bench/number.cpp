@@ -0,0 +1,129 @@
+#include "bench.hpp"
+#include <brigadier/exceptions.hpp>
+#include <brigadier/parser/Number.hpp>
+#include <brigadier/reader/StringReader.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
+#include <regex>
+#include <string>
+
+/**
+ * The previous implementation of the number readers, kept as a baseline:
+ * copy the token, match it against a regex, then convert it with std::sto*.
+ */
+namespace legacy {
+static auto INTEGER_REGEX = std::regex("^[-+]?[0-9]+$");
+static auto DECIMAL_REGEX = std::regex("^[-+]?[0-9]*\\.?[0-9]+$");
+
+template<typename T, typename Convert>
+static T read(brigadier::Reader &reader, const std::regex &regex, Convert convert)
+{
+    auto start = reader.getCursor();
+
+    try {
+        auto numberRepr = reader.readUnquotedString();
+        reader.skipWhitespace();
+
+        if (!std::regex_match(numberRepr, regex))
+            throw brigadier::CommandSyntaxException("Invalid number");
+        return convert(numberRepr);
+    } catch (const brigadier::CommandSyntaxException &) {
+    } catch (const std::out_of_range &) {
+    } catch (const std::invalid_argument &) {
+    }
+    reader.setCursor(start);
+    throw brigadier::CommandSyntaxException("Expected number");
+}
+
+static int readInt(brigadier::Reader &reader)
+{
+    return read<int>(reader, INTEGER_REGEX, [](const std::string &str) {
+        return std::stoi(str);
+    });
+}
+
+static double readDouble(brigadier::Reader &reader)
+{
+    return read<double>(reader, DECIMAL_REGEX, [](const std::string &str) {
+        return std::stod(str);
+    });
+}
+} // namespace legacy
+
+static const std::string INT_INPUT = "-1234567";
+static const std::string DOUBLE_INPUT = "-12345.6789";
+static const std::string INVALID_INPUT = "1234abc";
+
+BRIGADIER_BENCHMARK(number_int_legacy)
+{
+    brigadier::StringReader reader(INT_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(legacy::readInt(reader));
+    }
+}
+
+BRIGADIER_BENCHMARK(number_int_erased)
+{
+    brigadier::StringReader reader(INT_INPUT);
+    brigadier::Reader &erased = reader;
+    while (state.keepRunning()) {
+        erased.setCursor(0);
+        bench::doNotOptimize(erased.readInt());
+    }
+}
+
+BRIGADIER_BENCHMARK(number_int_view)
+{
+    brigadier::StringViewReader reader(INT_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(brigadier::NumberParser<int>::parse(reader));
+    }
+}
+
+BRIGADIER_BENCHMARK(number_double_legacy)
+{
+    brigadier::StringReader reader(DOUBLE_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(legacy::readDouble(reader));
+    }
+}
+
+BRIGADIER_BENCHMARK(number_double_view)
+{
+    brigadier::StringViewReader reader(DOUBLE_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(brigadier::NumberParser<double>::parse(reader));
+    }
+}
+
+BRIGADIER_BENCHMARK(number_hex_underscores_view)
+{
+    using parser = brigadier::NumberParser<long, brigadier::NumberFormat::Hex | brigadier::NumberFormat::Underscores>;
+    std::string input = "0x7FFF_FFFF_FFFF";
+    brigadier::StringViewReader reader(input);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(parser::parse(reader));
+    }
+}
+
+BRIGADIER_BENCHMARK(number_invalid_legacy)
+{
+    brigadier::StringReader reader(INVALID_INPUT);
+    while (state.keepRunning()) {
+        try {
+            legacy::readInt(reader);
+        } catch (const brigadier::CommandSyntaxException &) {
+        }
+    }
+}
+
+BRIGADIER_BENCHMARK(number_invalid_scan)
+{
+    brigadier::StringViewReader reader(INVALID_INPUT);
+    while (state.keepRunning())
+        bench::doNotOptimize(brigadier::_util::scanNumber<int>(reader, brigadier::NumberFormat::Decimal).error);
+}
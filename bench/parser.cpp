@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include <brigadier/parser/Bool.hpp>
+#include <brigadier/parser/Number.hpp>
+#include <brigadier/parser/String.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
+#include <string>
+
+/**
+ * Each parser through tryParse, on a valid and on an invalid input
+ */
+template<typename P>
+static void parseFrom(bench::State &state, const std::string &input)
+{
+    brigadier::StringViewReader reader(input);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(P::tryParse(reader));
+    }
+}
+
+#define BRIGADIER_PARSER_BENCHMARK(name, parser, valid, invalid) \
+    BRIGADIER_BENCHMARK(parser_##name##_valid)                   \
+    {                                                            \
+        static const std::string input = valid;                  \
+        parseFrom<parser>(state, input);                         \
+    }                                                            \
+    BRIGADIER_BENCHMARK(parser_##name##_invalid)                 \
+    {                                                            \
+        static const std::string input = invalid;                \
+        parseFrom<parser>(state, input);                         \
+    }
+
+BRIGADIER_PARSER_BENCHMARK(int, brigadier::NumberParser<int>, "-1234567", "1234abc")
+BRIGADIER_PARSER_BENCHMARK(long, brigadier::NumberParser<long>, "-1234567890123", "99999999999999999999")
+BRIGADIER_PARSER_BENCHMARK(float, brigadier::NumberParser<float>, "-123.456", "12.5.3")
+BRIGADIER_PARSER_BENCHMARK(double, brigadier::NumberParser<double>, "-12345.6789", "-.")
+BRIGADIER_PARSER_BENCHMARK(bool, brigadier::BoolParser, "true", "maybe")
+BRIGADIER_PARSER_BENCHMARK(string, brigadier::StringParser, "a_rather_long_unquoted_token", "\"unterminated")
+BRIGADIER_PARSER_BENCHMARK(string_view, brigadier::StringViewParser, "a_rather_long_unquoted_token", "\"unterminated")
+BRIGADIER_PARSER_BENCHMARK(greedy_string, brigadier::GreedyStringParser, "the rest of the line, quotes \" and all", "")
+BRIGADIER_PARSER_BENCHMARK(greedy_string_view, brigadier::GreedyStringViewParser, "the rest of the line, quotes \" and all", "")
@@ -0,0 +1,170 @@
+#include "bench.hpp"
+#include <brigadier/reader/StringReader.hpp>
+#include <brigadier/reader/ScanKernels.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
+#include <brigadier/reader/Tokens.hpp>
+#include <string>
+#include <utility>
+
+static const std::string UNQUOTED_INPUT = "minecraft:diamond_sword rest";
+static const std::string QUOTED_INPUT = "\"a quoted \\\"string\\\" with escapes\" rest";
+static const std::string UNTERMINATED_INPUT = "\"never closed";
+static const std::string WHITESPACE_INPUT = "                token";
+
+BRIGADIER_BENCHMARK(reader_unquoted_string)
+{
+    brigadier::StringReader reader(UNQUOTED_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.readUnquotedString());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_unquoted_view)
+{
+    brigadier::StringViewReader reader(UNQUOTED_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.readUnquotedView());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_quoted_string)
+{
+    brigadier::StringReader reader(QUOTED_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.readQuotedString());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_quoted_view)
+{
+    brigadier::StringViewReader reader(QUOTED_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.readQuotedView());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_string_view_erased)
+{
+    brigadier::StringViewReader reader(UNQUOTED_INPUT);
+    brigadier::Reader &erased = reader;
+    while (state.keepRunning()) {
+        erased.setCursor(0);
+        bench::doNotOptimize(erased.tryReadStringView());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_unterminated_quote_invalid)
+{
+    brigadier::StringViewReader reader(UNTERMINATED_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.tryReadStringView());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_skip_whitespace)
+{
+    brigadier::StringViewReader reader(WHITESPACE_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        reader.skipWhitespace();
+        bench::doNotOptimize(reader.getCursor());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_bool)
+{
+    brigadier::StringViewReader reader("false");
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.tryReadBool());
+    }
+}
+
+/**
+ * Long payloads, like books, signs and JSON text, at every scan level the CPU supports
+ */
+namespace {
+std::string makeBook()
+{
+    std::string book = "\"";
+    while (book.size() < 4096)
+        book += "{\\\"text\\\": \\\"Once upon a time, there was a block.\\\"} ";
+    return book + "\" rest";
+}
+
+const std::string LONG_QUOTED_INPUT = makeBook();
+const std::string LONG_UNQUOTED_INPUT = std::string(4096, 'a') + " rest";
+const std::string LONG_WHITESPACE_INPUT = std::string(1024, ' ') + "token";
+
+void readLong(bench::State &state, const std::string &input)
+{
+    brigadier::StringViewReader reader(input);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.tryReadStringView());
+    }
+}
+
+void skipLongWhitespace(bench::State &state)
+{
+    brigadier::StringViewReader reader(LONG_WHITESPACE_INPUT);
+    while (state.keepRunning()) {
+        reader.setCursor(0);
+        reader.skipWhitespace();
+        bench::doNotOptimize(reader.getCursor());
+    }
+}
+
+const bool registered = [] {
+    const std::pair<const char *, brigadier::ScanLevel> levels[] = {
+        {"scalar", brigadier::ScanLevel::Scalar},
+        {"sse2", brigadier::ScanLevel::Sse2},
+        {"avx2", brigadier::ScanLevel::Avx2},
+    };
+    auto initial = brigadier::getScanLevel();
+    for (auto [name, level] : levels) {
+        auto atLevel = [level, initial](void (*function)(bench::State &)) {
+            return [=](bench::State &state) {
+                brigadier::setScanLevel(level);
+                function(state);
+                brigadier::setScanLevel(initial);
+            };
+        };
+        if (!brigadier::setScanLevel(level))
+            continue;
+        bench::Registration(std::string("reader_quoted_4k_") + name, atLevel([](bench::State &state) { readLong(state, LONG_QUOTED_INPUT); }));
+        bench::Registration(std::string("reader_unquoted_4k_") + name, atLevel([](bench::State &state) { readLong(state, LONG_UNQUOTED_INPUT); }));
+        bench::Registration(std::string("reader_whitespace_1k_") + name, atLevel(skipLongWhitespace));
+    }
+    brigadier::setScanLevel(initial);
+    return true;
+}();
+} // namespace
+
+/**
+ * What a node does when its child lookup fails: read a token, move back, read it again as an argument
+ */
+static void readTwice(bench::State &state, brigadier::Tokens *tokens)
+{
+    while (state.keepRunning()) {
+        brigadier::StringViewReader reader(QUOTED_INPUT);
+        reader.setTokens(tokens);
+        bench::doNotOptimize(reader.tryReadStringView());
+        reader.setCursor(0);
+        bench::doNotOptimize(reader.tryReadStringView());
+        bench::doNotOptimize(reader.tryReadStringView());
+    }
+}
+
+BRIGADIER_BENCHMARK(reader_backtrack_scan) { readTwice(state, nullptr); }
+
+BRIGADIER_BENCHMARK(reader_backtrack_tokens)
+{
+    brigadier::Tokens tokens;
+    readTwice(state, &tokens);
+}
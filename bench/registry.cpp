@@ -0,0 +1,332 @@
+#include "bench.hpp"
+#include <brigadier/CommandNodeBuilder.hpp>
+#include <brigadier/ParallelDispatcher.hpp>
+#include <brigadier/Registry.hpp>
+#include <brigadier/SuggestionSession.hpp>
+#include <brigadier/parser/Number.hpp>
+#include <brigadier/parser/String.hpp>
+#include <deque>
+#include <string>
+
+static void fillRegistry(brigadier::Registry &registry)
+{
+    using namespace brigadier;
+
+    registry.add(CommandNodeBuilder("give", "Give items")
+                     .expectArg<StringViewParser>("player")
+                     .expectArg<NumberParser<int>>("count")
+                     .execute([](TypeHolder &, std::string_view player, int count) {
+                         bench::doNotOptimize(count);
+                     }));
+}
+
+static const std::string MALFORMED_INPUT = "give steve lots";
+
+BRIGADIER_BENCHMARK(registry_malformed_parse)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    while (state.keepRunning()) {
+        try {
+            registry.parse(MALFORMED_INPUT);
+        } catch (const brigadier::CommandSyntaxException &) {
+        }
+    }
+}
+
+BRIGADIER_BENCHMARK(registry_malformed_tryParse)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.tryParse(MALFORMED_INPUT).error().code);
+}
+
+BRIGADIER_BENCHMARK(registry_malformed_isValidInput)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.isValidInput(MALFORMED_INPUT));
+}
+
+static void fillWideRegistry(brigadier::Registry &registry, std::deque<std::string> &names, int &sum)
+{
+    using namespace brigadier;
+
+    std::vector<std::shared_ptr<ICommandNode>> nodes;
+    for (int i = 0; i < 2500; ++i) {
+        nodes.push_back(CommandNodeBuilder(names.emplace_back("command" + std::to_string(i)), "")
+                            .alias("alias" + std::to_string(i))
+                            .expectArg<NumberParser<int>>("n")
+                            .execute([&sum](brigadier::TypeHolder &, int n) {
+                                sum += n;
+                            })
+                            .build());
+    }
+    registry.addAll(nodes);
+}
+
+BRIGADIER_BENCHMARK(registry_dispatch_2500_roots)
+{
+    std::deque<std::string> names; // nodes only keep a view of their name
+    int sum = 0;
+    brigadier::Registry registry;
+    fillWideRegistry(registry, names, sum);
+    std::string input = "alias2499 1";
+    while (state.keepRunning())
+        registry.parse(input);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(registry_dispatch_2500_roots_frozen)
+{
+    std::deque<std::string> names;
+    int sum = 0;
+    brigadier::Registry registry;
+    fillWideRegistry(registry, names, sum);
+    auto compiled = registry.freeze();
+    std::string input = "alias2499 1";
+    while (state.keepRunning())
+        compiled.parse(input);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(registry_complete_2500_roots)
+{
+    std::deque<std::string> names;
+    int sum = 0;
+    brigadier::Registry registry;
+    fillWideRegistry(registry, names, sum);
+    brigadier::TypeHolder holder;
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        brigadier::StringViewReader reader("command249");
+        brigadier::SuggestionsBuilder builder(count);
+        registry.listSuggestions(holder, reader, builder);
+    }
+    bench::doNotOptimize(found);
+}
+
+BRIGADIER_BENCHMARK(registry_complete_2500_roots_scan)
+{
+    std::deque<std::string> names;
+    int sum = 0;
+    brigadier::Registry registry;
+    fillWideRegistry(registry, names, sum);
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        // What completion costs without the sorted index
+        brigadier::SuggestionsBuilder builder(count, brigadier::SuggestionsBuilder::unlimited, "command249");
+        for (auto &node : registry.getChildren()) {
+            builder.suggest(node->getName());
+            for (auto &alias : node->getAliases())
+                builder.suggest(alias);
+        }
+    }
+    bench::doNotOptimize(found);
+}
+
+static const std::string VALID_INPUT = "give steve 64";
+
+BRIGADIER_BENCHMARK(registry_validate_then_parse)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    while (state.keepRunning()) {
+        if (registry.isValidInput(VALID_INPUT))
+            registry.parse(VALID_INPUT);
+    }
+}
+
+BRIGADIER_BENCHMARK(registry_parseOnly_then_execute)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    while (state.keepRunning()) {
+        auto results = registry.parseOnly(nullptr, VALID_INPUT);
+        if (results)
+            registry.execute(results);
+    }
+}
+
+BRIGADIER_BENCHMARK(registry_parse_cached)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    registry.setCacheCapacity(1024);
+    while (state.keepRunning())
+        registry.parse(VALID_INPUT);
+}
+
+BRIGADIER_BENCHMARK(registry_parse_uncached)
+{
+    brigadier::Registry registry;
+    fillRegistry(registry);
+    while (state.keepRunning())
+        registry.parse(VALID_INPUT);
+}
+
+static std::vector<std::string> makeBatchInputs()
+{
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 1000; ++i)
+        inputs.push_back((i % 2 ? "alias" : "command") + std::to_string((i * 7919) % 2500) + " " + std::to_string(i));
+    return inputs;
+}
+
+BRIGADIER_BENCHMARK(registry_batch_1000_loop)
+{
+    std::deque<std::string> names;
+    int sum = 0;
+    brigadier::Registry registry;
+    fillWideRegistry(registry, names, sum);
+    auto inputs = makeBatchInputs();
+    while (state.keepRunning()) {
+        for (auto &input : inputs)
+            bench::doNotOptimize(registry.tryParse(input));
+    }
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(registry_batch_1000_parseBatch)
+{
+    std::deque<std::string> names;
+    int sum = 0;
+    brigadier::Registry registry;
+    fillWideRegistry(registry, names, sum);
+    auto inputs = makeBatchInputs();
+    std::vector<brigadier::Command> commands;
+    for (auto &input : inputs)
+        commands.push_back({nullptr, input});
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.parseBatch(commands));
+    bench::doNotOptimize(sum);
+}
+
+static void fillDeepRegistry(brigadier::Registry &registry)
+{
+    using namespace brigadier;
+    using S = StringViewParser;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("data", "")
+        .add(CommandNodeBuilder("modify", "")
+            .add(CommandNodeBuilder("entity", "")
+                .expectArg<S>("a").expectArg<S>("b").expectArg<S>("c").expectArg<S>("d")
+                .expectArg<S>("e").expectArg<S>("f").expectArg<S>("g").expectArg<S>("h")
+                .execute([](TypeHolder &, auto...) {})
+                .suggestionBuilder([](TypeHolder &, SuggestionsBuilder &builder) {
+                    builder.suggest("value");
+                })
+            )
+        )
+    );
+    // clang-format on
+}
+
+static const std::string LONG_LINE = "data modify entity first_argument_that_is_long second_argument_that_is_long "
+                                     "third_argument_that_is_long fourth_argument_that_is_long fifth_argument_that_is_long "
+                                     "sixth_argument_that_is_long seventh_argument_that_is_long eighth";
+
+BRIGADIER_BENCHMARK(registry_keystrokes_from_scratch)
+{
+    brigadier::Registry registry;
+    fillDeepRegistry(registry);
+    brigadier::TypeHolder holder;
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        // The last 32 keystrokes of the line, each re-parsed from the start
+        for (size_t i = LONG_LINE.size() - 32; i <= LONG_LINE.size(); ++i) {
+            brigadier::StringViewReader reader(std::string_view(LONG_LINE).substr(0, i));
+            brigadier::SuggestionsBuilder builder(count);
+            registry.listSuggestions(holder, reader, builder);
+        }
+    }
+    bench::doNotOptimize(found);
+}
+
+BRIGADIER_BENCHMARK(registry_keystrokes_session)
+{
+    brigadier::Registry registry;
+    fillDeepRegistry(registry);
+    brigadier::TypeHolder holder;
+    brigadier::SuggestionSession session(registry);
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        for (size_t i = LONG_LINE.size() - 32; i <= LONG_LINE.size(); ++i) {
+            brigadier::SuggestionsBuilder builder(count);
+            session.listSuggestions(holder, std::string_view(LONG_LINE).substr(0, i), builder);
+        }
+    }
+    bench::doNotOptimize(found);
+}
+
+/**
+ * "give <player> <count>" for each of 256 sources, with a callback doing some work, and "execute as <count> run ..." forking to them
+ */
+static void fillForkRegistry(brigadier::Registry &registry, std::vector<int> &sources, brigadier::Executor *executor)
+{
+    using namespace brigadier;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "")
+        .expectArg<StringViewParser>("player")
+        .expectArg<NumberParser<int>>("count")
+        .execute([](TypeHolder &source, std::string_view player, int count) {
+            auto hash = static_cast<size_t>(source.getAs<int>());
+            for (int i = 0; i < count; ++i)
+                hash = (hash ^ std::hash<std::string_view>()(player)) * 1099511628211u;
+            bench::doNotOptimize(hash);
+        })
+    );
+    registry.add(CommandNodeBuilder("execute", "")
+        .add(CommandNodeBuilder("as", "")
+            .expectArg<NumberParser<int>>("count")
+            .fork(registry, "execute", [&sources](TypeHolder &, int count) {
+                std::vector<TypeHolder> selected;
+                selected.reserve(static_cast<size_t>(count));
+                for (int i = 0; i < count; ++i)
+                    selected.emplace_back(sources[static_cast<size_t>(i)]);
+                return selected;
+            }, executor, 64)
+        )
+        .add(CommandNodeBuilder("run", "").redirect(registry))
+    );
+    // clang-format on
+}
+
+BRIGADIER_BENCHMARK(registry_as_256_redispatch)
+{
+    std::vector<int> sources(256);
+    brigadier::Registry registry;
+    fillForkRegistry(registry, sources, nullptr);
+    while (state.keepRunning()) {
+        for (auto &source : sources)
+            bench::doNotOptimize(registry.tryParse(brigadier::TypeHolder(source), "give steve 1"));
+    }
+}
+
+BRIGADIER_BENCHMARK(registry_as_256_fork)
+{
+    std::vector<int> sources(256);
+    brigadier::Registry registry;
+    fillForkRegistry(registry, sources, nullptr);
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.tryParse("execute as 256 run give steve 1"));
+}
+
+BRIGADIER_BENCHMARK(registry_as_256_fork_parallel)
+{
+    std::vector<int> sources(256);
+    brigadier::Registry empty;
+    brigadier::ParallelDispatcher dispatcher(empty, 4);
+    brigadier::Registry registry;
+    fillForkRegistry(registry, sources, &dispatcher);
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.tryParse("execute as 256 run give steve 1"));
+}
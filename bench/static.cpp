@@ -0,0 +1,186 @@
+#include "bench.hpp"
+#include <brigadier/CommandNodeBuilder.hpp>
+#include <brigadier/Registry.hpp>
+#include <brigadier/StaticRegistry.hpp>
+#include <brigadier/parser/Number.hpp>
+#include <brigadier/parser/String.hpp>
+#include <deque>
+#include <string>
+#include <utility>
+
+/**
+ * The same trees as a `StaticRegistry`, a `Registry` and a `CompiledRegistry`
+ */
+namespace {
+int sum = 0;
+
+void give(brigadier::TypeHolder &, std::string_view player, int count) { sum += count; }
+
+void add(brigadier::TypeHolder &, int n) { sum += n; }
+
+using namespace brigadier;
+
+using GiveTree = StaticRegistry<Literal<"give", Alias<"g">, Args<StringViewParser, NumberParser<int>>, Executes<&give>>>;
+
+void fillGiveRegistry(Registry &registry)
+{
+    registry.add(CommandNodeBuilder("give", "").alias("g").expectArg<StringViewParser>("player").expectArg<NumberParser<int>>("count").execute(&give));
+}
+
+constexpr size_t wideCount = 256;
+
+/**
+ * "c<i>", or "a_c<i>" for its alias
+ */
+template<size_t I, bool Alias>
+constexpr auto commandName()
+{
+    constexpr size_t digits = I < 10 ? 1 : I < 100 ? 2 : 3;
+    constexpr size_t prefix = Alias ? 3 : 1;
+    char name[prefix + digits + 1] {};
+    std::copy_n(Alias ? "a_c" : "c", prefix, name);
+    for (size_t i = 0, n = I; i < digits; ++i, n /= 10)
+        name[prefix + digits - 1 - i] = static_cast<char>('0' + n % 10);
+    return _util::FixedString<prefix + digits + 1>(name);
+}
+
+template<typename Sequence>
+struct Wide;
+
+template<size_t... I>
+struct Wide<std::index_sequence<I...>> {
+    using type = StaticRegistry<Literal<commandName<I, false>(), Alias<commandName<I, true>()>, Args<NumberParser<int>>, Executes<&add>>...>;
+};
+
+using WideTree = Wide<std::make_index_sequence<wideCount>>::type;
+
+void fillWideRegistry(Registry &registry, std::deque<std::string> &names)
+{
+    std::vector<std::shared_ptr<ICommandNode>> nodes;
+    for (size_t i = 0; i < wideCount; ++i) {
+        auto &name = names.emplace_back("c" + std::to_string(i));
+        nodes.push_back(CommandNodeBuilder(name, "").alias("a_" + name).expectArg<NumberParser<int>>("n").execute(&add).build());
+    }
+    registry.reload(std::move(nodes));
+}
+
+const std::string GIVE_INPUT = "give steve 64";
+const std::string GIVE_MALFORMED_INPUT = "give steve lots";
+const std::string WIDE_INPUT = "a_c255 1";
+} // namespace
+
+BRIGADIER_BENCHMARK(static_give_parse)
+{
+    GiveTree tree;
+    while (state.keepRunning())
+        tree.parse(GIVE_INPUT);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(static_give_parse_runtime)
+{
+    Registry registry;
+    fillGiveRegistry(registry);
+    while (state.keepRunning())
+        registry.parse(GIVE_INPUT);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(static_give_parse_frozen)
+{
+    Registry registry;
+    fillGiveRegistry(registry);
+    auto compiled = registry.freeze();
+    while (state.keepRunning())
+        compiled.parse(GIVE_INPUT);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(static_give_malformed_tryParse)
+{
+    GiveTree tree;
+    while (state.keepRunning())
+        bench::doNotOptimize(tree.tryParse(GIVE_MALFORMED_INPUT).error().code);
+}
+
+BRIGADIER_BENCHMARK(static_give_malformed_tryParse_runtime)
+{
+    Registry registry;
+    fillGiveRegistry(registry);
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.tryParse(GIVE_MALFORMED_INPUT).error().code);
+}
+
+BRIGADIER_BENCHMARK(static_give_isValidInput)
+{
+    GiveTree tree;
+    while (state.keepRunning())
+        bench::doNotOptimize(tree.isValidInput(GIVE_INPUT));
+}
+
+BRIGADIER_BENCHMARK(static_give_isValidInput_runtime)
+{
+    Registry registry;
+    fillGiveRegistry(registry);
+    while (state.keepRunning())
+        bench::doNotOptimize(registry.isValidInput(GIVE_INPUT));
+}
+
+BRIGADIER_BENCHMARK(static_256_roots_parse)
+{
+    WideTree tree;
+    while (state.keepRunning())
+        tree.parse(WIDE_INPUT);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(static_256_roots_parse_runtime)
+{
+    std::deque<std::string> names; // nodes only keep a view of their name
+    Registry registry;
+    fillWideRegistry(registry, names);
+    while (state.keepRunning())
+        registry.parse(WIDE_INPUT);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(static_256_roots_parse_frozen)
+{
+    std::deque<std::string> names;
+    Registry registry;
+    fillWideRegistry(registry, names);
+    auto compiled = registry.freeze();
+    while (state.keepRunning())
+        compiled.parse(WIDE_INPUT);
+    bench::doNotOptimize(sum);
+}
+
+BRIGADIER_BENCHMARK(static_256_roots_complete)
+{
+    WideTree tree;
+    TypeHolder holder;
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        StringViewReader reader("c25");
+        SuggestionsBuilder builder(count);
+        tree.listSuggestions(holder, reader, builder);
+    }
+    bench::doNotOptimize(found);
+}
+
+BRIGADIER_BENCHMARK(static_256_roots_complete_runtime)
+{
+    std::deque<std::string> names;
+    Registry registry;
+    fillWideRegistry(registry, names);
+    TypeHolder holder;
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        StringViewReader reader("c25");
+        SuggestionsBuilder builder(count);
+        registry.listSuggestions(holder, reader, builder);
+    }
+    bench::doNotOptimize(found);
+}
@@ -0,0 +1,161 @@
+#include "bench.hpp"
+#include <brigadier/CommandNodeBuilder.hpp>
+#include <brigadier/Registry.hpp>
+#include <brigadier/parser/Number.hpp>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Synthetic trees of about `commands` leaves: `depth` levels of literals with the same fan-out,
+ * `aliases` aliases per literal, and an integer argument on the leaves
+ */
+namespace {
+struct Shape {
+    size_t commands;
+    size_t depth;
+    size_t aliases;
+
+    std::string name() const { return "tree_" + std::to_string(commands) + "_depth" + std::to_string(depth) + "_aliases" + std::to_string(aliases); }
+};
+
+struct SyntheticTree {
+    std::deque<std::string> names; // nodes only keep a view of their name
+    brigadier::Registry registry;
+    int sum = 0;
+    std::string valid;   ///< The last command, with a valid argument
+    std::string invalid; ///< The last command, with an argument that is not a number
+    std::string unknown; ///< A root that does not exist
+    std::string partial; ///< The last command with only the first letter of its last literal, every sibling completes
+
+    explicit SyntheticTree(const Shape &shape)
+    {
+        auto fanOut = std::max<size_t>(2, static_cast<size_t>(std::lround(std::pow(double(shape.commands), 1.0 / double(shape.depth)))));
+        if (shape.depth == 1)
+            fanOut = shape.commands;
+        for (size_t i = 0; i < fanOut; ++i)
+            names.emplace_back("c" + std::to_string(i));
+
+        registry.addAll(level(shape, fanOut, shape.depth));
+
+        std::string path;
+        for (size_t i = 0; i < shape.depth; ++i)
+            path += names.back() + " ";
+        valid = path + "42";
+        invalid = path + "forty";
+        unknown = "unknown 42";
+        partial = path.substr(0, path.size() - names.back().size() - 1) + "c";
+    }
+
+    SyntheticTree(const SyntheticTree &) = delete;
+    SyntheticTree &operator=(const SyntheticTree &) = delete;
+
+    std::vector<std::shared_ptr<brigadier::ICommandNode>> level(const Shape &shape, size_t fanOut, size_t remaining)
+    {
+        using namespace brigadier;
+
+        std::vector<std::shared_ptr<ICommandNode>> nodes;
+        nodes.reserve(fanOut);
+        for (size_t i = 0; i < fanOut; ++i) {
+            if (remaining == 1) {
+                auto builder = CommandNodeBuilder(names[i]).expectArg<NumberParser<int>>("n");
+                builder.execute([this](TypeHolder &, int n) { sum += n; });
+                for (size_t k = 0; k < shape.aliases; ++k)
+                    builder.alias("a" + std::to_string(k) + "_" + names[i]);
+                nodes.push_back(builder.build());
+                continue;
+            }
+            CommandNodeBuilder builder(names[i]);
+            for (size_t k = 0; k < shape.aliases; ++k)
+                builder.alias("a" + std::to_string(k) + "_" + names[i]);
+            for (auto &child : level(shape, fanOut, remaining - 1))
+                builder.add(std::move(child));
+            nodes.push_back(builder.build());
+        }
+        return nodes;
+    }
+};
+
+SyntheticTree &tree(const Shape &shape)
+{
+    static std::map<std::string, std::unique_ptr<SyntheticTree>> trees;
+    auto &tree = trees[shape.name()];
+    if (!tree)
+        tree = std::make_unique<SyntheticTree>(shape);
+    return *tree;
+}
+
+void parseValid(bench::State &state, const Shape &shape)
+{
+    auto &fixture = tree(shape);
+    while (state.keepRunning())
+        fixture.registry.parse(fixture.valid);
+    bench::doNotOptimize(fixture.sum);
+}
+
+void tryParseInvalid(bench::State &state, const Shape &shape)
+{
+    auto &fixture = tree(shape);
+    while (state.keepRunning())
+        bench::doNotOptimize(fixture.registry.tryParse(fixture.invalid).error().code);
+}
+
+void tryParseUnknown(bench::State &state, const Shape &shape)
+{
+    auto &fixture = tree(shape);
+    while (state.keepRunning())
+        bench::doNotOptimize(fixture.registry.tryParse(fixture.unknown).error().code);
+}
+
+void isValidInputValid(bench::State &state, const Shape &shape)
+{
+    auto &fixture = tree(shape);
+    while (state.keepRunning())
+        bench::doNotOptimize(fixture.registry.isValidInput(fixture.valid));
+}
+
+void isValidInputInvalid(bench::State &state, const Shape &shape)
+{
+    auto &fixture = tree(shape);
+    while (state.keepRunning())
+        bench::doNotOptimize(fixture.registry.isValidInput(fixture.invalid));
+}
+
+void listSuggestions(bench::State &state, const Shape &shape)
+{
+    auto &fixture = tree(shape);
+    brigadier::TypeHolder holder;
+    size_t found = 0;
+    auto count = [&found](std::string_view) { ++found; };
+    while (state.keepRunning()) {
+        brigadier::StringViewReader reader(fixture.partial);
+        brigadier::SuggestionsBuilder builder(count);
+        fixture.registry.listSuggestions(holder, reader, builder);
+    }
+    bench::doNotOptimize(found);
+}
+
+const bool registered = [] {
+    const std::pair<const char *, void (*)(bench::State &, const Shape &)> cases[] = {
+        {"parse_valid", parseValid},
+        {"tryParse_invalid", tryParseInvalid},
+        {"tryParse_unknown", tryParseUnknown},
+        {"isValidInput_valid", isValidInputValid},
+        {"isValidInput_invalid", isValidInputInvalid},
+        {"listSuggestions", listSuggestions},
+    };
+    for (size_t commands : {10, 1000, 100000}) {
+        for (size_t depth : {1, 3}) {
+            for (size_t aliases : {0, 2}) {
+                Shape shape {commands, depth, aliases};
+                for (auto [name, function] : cases)
+                    bench::Registration(shape.name() + "_" + name, [shape, function](bench::State &state) { function(state, shape); });
+            }
+        }
+    }
+    return true;
+}();
+} // namespace
@@ -1,10 +1,25 @@
 #pragma once
 
+#include <brigadier/Ambiguity.hpp>
+#include <brigadier/Arena.hpp>
 #include <brigadier/Argument.hpp>
 #include <brigadier/CommandNode.hpp>
 #include <brigadier/CommandNodeBuilder.hpp>
+#include <brigadier/CompiledRegistry.hpp>
+#include <brigadier/Executor.hpp>
+#include <brigadier/Function.hpp>
+#include <brigadier/Metrics.hpp>
+#include <brigadier/ParallelDispatcher.hpp>
+#include <brigadier/ParseCache.hpp>
+#include <brigadier/ParseResults.hpp>
+#include <brigadier/Redirect.hpp>
 #include <brigadier/Parser.hpp>
 #include <brigadier/Registry.hpp>
+#include <brigadier/Result.hpp>
+#include <brigadier/StaticRegistry.hpp>
+#include <brigadier/SuggestionSession.hpp>
+#include <brigadier/SuggestionsBuilder.hpp>
+#include <brigadier/Tracing.hpp>
 #include <brigadier/TypeHolder.hpp>
 #include <brigadier/exceptions.hpp>
 #include <brigadier/options.hpp>
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <brigadier/Function.hpp>
+
+namespace brigadier {
+class ICommandNode;
+
+/**
+ * @brief A token the dispatcher could read in two ways, found by `Registry::findAmbiguities`
+ *
+ * Dispatch stays deterministic, the token always goes to `taken`: the report is about `hidden`,
+ * which never gets it and is likely a mistake in the tree.
+ */
+struct Ambiguity {
+    enum Kind : uint8_t {
+        DuplicateLiteral, ///< Two siblings share a name or alias, the one added first gets the token
+        ShadowedArgument, ///< A child is named like a valid value of the first argument of its parent, the child gets the token
+    };
+
+    Kind kind;
+    std::string path;           ///< Names from the root to the parent, separated by spaces, empty for root commands
+    std::string token;          ///< The name or alias read in two ways
+    const ICommandNode *taken;  ///< The child the dispatcher picks
+    const ICommandNode *hidden; ///< The other sibling, or the parent whose argument never gets the token
+};
+
+/**
+ * @brief Called with each ambiguity found
+ */
+using AmbiguityConsumer = Function<void(const Ambiguity &)>;
+} // namespace brigadier
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace brigadier {
+/**
+ * @brief A monotonic memory resource for the temporary data of a command, freed all at once
+ *
+ * Allocations are served from an inline buffer, then from the heap once it is exhausted.
+ * Deallocation is a no-op, `reset` makes the whole buffer available again.
+ *
+ * @code
+ * brigadier::Arena arena;
+ * brigadier::StringViewReader reader(input);
+ * reader.setMemoryResource(&arena);
+ * registry.parse(player, reader);
+ * arena.reset();
+ * @endcode
+ */
+class Arena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t defaultCapacity = 4096;
+
+    /**
+     * @brief Release a thread-local arena when destroyed, resetting it
+     */
+    class Lease {
+    public:
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        ~Lease()
+        {
+            _arena->reset();
+            --pool().used;
+        }
+
+        Arena *get() const { return _arena; }
+        Arena &operator*() const { return *_arena; }
+        Arena *operator->() const { return _arena; }
+
+    private:
+        friend class Arena;
+
+        explicit Lease(Arena *arena):
+            _arena(arena)
+        {
+        }
+
+        Arena *_arena;
+    };
+
+    /**
+     * @param capacity The size of the inline buffer, in bytes
+     */
+    explicit Arena(size_t capacity = defaultCapacity):
+        _buffer(std::make_unique<std::byte[]>(capacity)),
+        _resource(_buffer.get(), capacity, std::pmr::new_delete_resource())
+    {
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Free everything allocated since the last reset
+     */
+    void reset()
+    {
+        if (_dirty)
+            _resource.release();
+        _dirty = false;
+    }
+
+    /**
+     * @brief Borrow an arena from the pool of the calling thread
+     *
+     * Nested leases, e.g. a callback parsing another command, get distinct arenas.
+     * Arenas are only allocated the first time a thread needs them.
+     *
+     * @return Lease
+     */
+    static Lease local()
+    {
+        auto &arenas = pool();
+        if (arenas.used == arenas.arenas.size())
+            arenas.arenas.push_back(std::make_unique<Arena>());
+        return Lease(arenas.arenas[arenas.used++].get());
+    }
+
+private:
+    struct Pool {
+        std::vector<std::unique_ptr<Arena>> arenas;
+        size_t used = 0;
+    };
+
+    static Pool &pool()
+    {
+        static thread_local Pool pool;
+        return pool;
+    }
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        _dirty = true;
+        return _resource.allocate(bytes, alignment);
+    }
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    std::unique_ptr<std::byte[]> _buffer;
+    std::pmr::monotonic_buffer_resource _resource;
+    bool _dirty = false; ///< Whether something was allocated since the last reset
+};
+} // namespace brigadier
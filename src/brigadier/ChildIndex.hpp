@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <brigadier/ICommandNode.hpp>
+
+namespace brigadier::_util {
+/**
+ * @brief FNV-1a hash of a command name, shared by the dispatch tables
+ */
+constexpr uint32_t hashName(std::string_view name)
+{
+    uint32_t hash = 2166136261u;
+    for (auto c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Index of command nodes by name and alias
+ *
+ * A flat open-addressing hash table: a lookup hashes the token once and compares it
+ * against the few keys sharing its hash, whatever the number of nodes.
+ * When several nodes share a name, the first one added wins, as with a linear scan.
+ *
+ * The keys are also sorted, case-sensitively and case-insensitively, so that completing
+ * a prefix is a binary search followed by a walk over the k matching keys. Adding a node only
+ * appends its keys, they are sorted once by `sortKeys` when the index is complete.
+ *
+ * Their first characters form the first-token table of the node: a token starting with any other
+ * character, unless quoted, cannot be a key, and nodes go straight to their arguments without looking it up.
+ */
+class ChildIndex {
+public:
+    /**
+     * @brief Index a node by its name and aliases
+     *
+     * It can be found right away, but is only completed once the keys are sorted again by `sortKeys`.
+     *
+     * @param node
+     */
+    void add(const std::shared_ptr<ICommandNode> &node)
+    {
+        insert(node->getName(), node.get());
+        for (auto &alias : node->getAliases())
+            insert(alias, node.get());
+    }
+
+    /**
+     * @brief Index many nodes and sort the keys
+     *
+     * @param nodes
+     */
+    void addAll(std::span<const std::shared_ptr<ICommandNode>> nodes)
+    {
+        for (auto &node : nodes)
+            add(node);
+        sortKeys();
+    }
+
+    /**
+     * @brief Sort the keys added since the last call, to be done before completing prefixes
+     *
+     * The new keys are sorted on their own then merged, so sorting after each node stays linear.
+     */
+    void sortKeys()
+    {
+        if (_sorted.size() == _entries.size())
+            return;
+        sort(_sorted, false);
+        sort(_folded, true);
+    }
+
+    /**
+     * @brief Find the node named or aliased key
+     *
+     * @param key
+     * @return ICommandNode* nullptr if there is none
+     */
+    ICommandNode *find(std::string_view key) const
+    {
+        if (_slots.empty())
+            return nullptr;
+        auto hash = hashName(key);
+        for (auto i = hash & mask();; i = (i + 1) & mask()) {
+            auto &slot = _slots[i];
+            if (slot.entry == 0)
+                return nullptr;
+            if (slot.hash == hash && _entries[slot.entry - 1].key == key)
+                return _entries[slot.entry - 1].node;
+        }
+    }
+
+    /**
+     * @brief Call f with every key starting with prefix and its node, in order, until f returns false
+     *
+     * @param prefix
+     * @param ignoreCase Whether to compare ASCII letters case-insensitively
+     * @param f Called with (std::string_view key, ICommandNode *node), returns bool
+     */
+    template<typename F>
+    void forEachPrefixed(std::string_view prefix, bool ignoreCase, F &&f) const
+    {
+        auto &order = ignoreCase ? _folded : _sorted;
+        auto it = std::lower_bound(order.begin(), order.end(), prefix, [&](uint32_t entry, std::string_view key) {
+            return less(_entries[entry].key, key, ignoreCase);
+        });
+        for (; it != order.end() && startsWith(_entries[*it].key, prefix, ignoreCase); ++it) {
+            if (!f(std::string_view(_entries[*it].key), _entries[*it].node))
+                return;
+        }
+    }
+
+    size_t size() const { return _entries.size(); }
+
+    /**
+     * @brief Whether a key starts with c
+     *
+     * @param c
+     * @return bool
+     */
+    bool startsAKey(char c) const
+    {
+        auto byte = static_cast<unsigned char>(c);
+        return (_firstChars[byte >> 6] >> (byte & 63)) & 1;
+    }
+
+    static constexpr char fold(char c, bool ignoreCase) { return ignoreCase && c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    static constexpr bool less(std::string_view lhs, std::string_view rhs, bool ignoreCase)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [ignoreCase](char l, char r) {
+            return static_cast<unsigned char>(fold(l, ignoreCase)) < static_cast<unsigned char>(fold(r, ignoreCase));
+        });
+    }
+
+    static constexpr bool startsWith(std::string_view key, std::string_view prefix, bool ignoreCase)
+    {
+        return key.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), key.begin(), [ignoreCase](char p, char k) {
+            return fold(p, ignoreCase) == fold(k, ignoreCase);
+        });
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        ICommandNode *node;
+    };
+
+    struct Slot {
+        uint32_t hash = 0;
+        uint32_t entry = 0; ///< Index in _entries plus one, 0 for an empty slot
+    };
+
+    size_t mask() const { return _slots.size() - 1; }
+
+    /**
+     * @brief Sort the entries missing from order, then merge them into it
+     */
+    void sort(std::vector<uint32_t> &order, bool ignoreCase)
+    {
+        auto sorted = static_cast<std::ptrdiff_t>(order.size());
+        for (auto entry = static_cast<uint32_t>(sorted); entry < _entries.size(); ++entry)
+            order.push_back(entry);
+        auto byKey = [&](uint32_t lhs, uint32_t rhs) {
+            return less(_entries[lhs].key, _entries[rhs].key, ignoreCase);
+        };
+        std::stable_sort(order.begin() + sorted, order.end(), byKey);
+        std::inplace_merge(order.begin(), order.begin() + sorted, order.end(), byKey);
+    }
+
+    void insert(std::string_view key, ICommandNode *node)
+    {
+        if (find(key) != nullptr)
+            return;
+        if ((_entries.size() + 1) * 2 > _slots.size())
+            rehash(_slots.empty() ? 16 : _slots.size() * 2);
+        _entries.push_back({std::string(key), node});
+        place(hashName(key), static_cast<uint32_t>(_entries.size()));
+        if (!key.empty()) {
+            auto byte = static_cast<unsigned char>(key.front());
+            _firstChars[byte >> 6] |= uint64_t(1) << (byte & 63);
+        }
+    }
+
+    void place(uint32_t hash, uint32_t entry)
+    {
+        auto i = hash & mask();
+        while (_slots[i].entry != 0)
+            i = (i + 1) & mask();
+        _slots[i] = {hash, entry};
+    }
+
+    void rehash(size_t capacity)
+    {
+        _slots.assign(capacity, Slot {});
+        for (size_t i = 0; i < _entries.size(); ++i)
+            place(hashName(_entries[i].key), static_cast<uint32_t>(i + 1));
+    }
+
+private:
+    std::vector<Slot> _slots;
+    std::vector<Entry> _entries;
+    std::vector<uint32_t> _sorted; ///< Indices in _entries, by key, up to the last `sortKeys`
+    std::vector<uint32_t> _folded; ///< Indices in _entries, by case-folded key, up to the last `sortKeys`
+    std::array<uint64_t, 4> _firstChars {}; ///< Bit set of the first characters of the keys
+};
+
+/**
+ * @brief Suggest the names and aliases of the children completing the token being typed
+ *
+ * Nothing is suggested unless the rest of the input is a single unfinished unquoted token, possibly empty.
+ * Children the source cannot use are skipped.
+ *
+ * @param index The children
+ * @param holder
+ * @param reader Placed at the token
+ * @param builder
+ */
+inline void suggestLiterals(const ChildIndex &index, const TypeHolder &holder, const Reader &reader, SuggestionsBuilder &builder)
+{
+    auto partial = reader.getRemainingView();
+    if (!std::ranges::all_of(partial, [&reader](char c) { return reader.isAllowedInUnquotedString(c); }))
+        return;
+    index.forEachPrefixed(partial, builder.isCaseInsensitive(), [&](std::string_view key, const ICommandNode *node) {
+        return !node->canUse(holder) || builder.suggest(key);
+    });
+}
+} // namespace brigadier::_util
@@ -4,11 +4,15 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
 #include <brigadier/Argument.hpp>
+#include <brigadier/ChildIndex.hpp>
+#include <brigadier/Function.hpp>
 #include <brigadier/ICommandNode.hpp>
 #include <brigadier/Parser.hpp>
+#include <brigadier/Redirect.hpp>
 #include <brigadier/TypeHolder.hpp>
 #include <brigadier/exceptions.hpp>
 
@@ -36,61 +40,199 @@ public:
      * @param description
      * @param arguments
      * @param children
+     * @param index The index of children by name and alias
      * @param aliases
      * @param permissionPredicate
      * @param callback
      * @param suggestionProvider
+     * @param redirect Where the rest of the input goes once the arguments are parsed, instead of the callback
      */
     CommandNode(
         const std::string_view &name, const std::string_view &description, const std::vector<Argument> &arguments, const std::vector<std::shared_ptr<ICommandNode>> &children,
-        const std::vector<std::string> &aliases, const std::function<bool(const TypeHolder &)> &permissionPredicate,
-        const std::function<void(TypeHolder &, typename Parsers::type...)> &callback, const std::function<std::vector<std::string>(TypeHolder &)> &suggestionProvider
+        const _util::ChildIndex &index, const std::vector<std::string> &aliases, Function<bool(const TypeHolder &)> permissionPredicate,
+        Function<void(TypeHolder &, typename Parsers::type...)> callback, Function<void(TypeHolder &, SuggestionsBuilder &)> suggestionProvider,
+        std::unique_ptr<const _util::Redirect<typename Parsers::type...>> redirect = nullptr
     ):
         _name(name),
         _description(description),
         _arguments(arguments),
         _children(children),
+        _index(index),
         _aliases(aliases),
-        _permissionPredicate(permissionPredicate),
-        _callback(callback),
-        _suggestionProvider(suggestionProvider)
+        _permissionPredicate(std::move(permissionPredicate)),
+        _callback(std::move(callback)),
+        _suggestionProvider(std::move(suggestionProvider)),
+        _redirect(std::move(redirect))
     {
     }
 
 public:
     /**
-     * @brief Parse and execute the command
+     * @brief Parse and execute the command without throwing on invalid input
      *
-     * @throw CommandSyntaxException If the command is invalid
-     * @throw ParserException If a parser fails
+     * @param source The source of the command
+     * @param reader The reader to parse the command from
+     * @return Result<void>
+     */
+    Result<void> tryParse(TypeHolder &source, Reader &reader) const override { return tryParse<Reader>(source, reader); }
+
+    /**
+     * @see CommandNode::tryParse
+     */
+    Result<void> tryParse(TypeHolder &source, StringViewReader &reader) const override { return tryParse<StringViewReader>(source, reader); }
+
+    /**
+     * @brief Parse and execute the command with a statically known reader
+     *
+     * The arguments are parsed from left to right, the callback is only called once all of them are parsed.
      *
+     * @tparam R The reader type, calls to its `final` members get inlined
      * @param source The source of the command
      * @param reader The reader to parse the command from
+     * @return Result<void>
      */
-    void parse(TypeHolder &source, Reader &reader) const override
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    Result<void> tryParse(TypeHolder &source, R &reader) const
     {
         auto start = reader.getCursor();
-        try {
-            if (reader.canRead()) {
-                auto entry = reader.readString();
-                for (auto &child : _children) {
-                    if (child->getName() == entry || std::find(child->getAliases().begin(), child->getAliases().end(), entry) != child->getAliases().end()) {
-                        child->parse(source, reader);
-                        return;
-                    }
-                }
-                reader.setCursor(start);
+        _util::TraceSpan span("node", start, [this] { return _name; });
+        if (mayReadChild(reader)) {
+            auto entry = reader.tryReadStringView();
+            if (auto child = entry ? _index.find(*entry) : nullptr) {
+                auto result = child->tryParse(source, reader);
+                if (!result)
+                    reader.setCursor(start);
+                span.close(result, reader);
+                return result;
             }
-            if (_callback == nullptr)
-                throw CommandSyntaxException("Invalid command", reader);
-            _callback(source, Parsers::parse(reader)...);
-        } catch (ReaderException &e) {
-            reader.setCursor(start);
-            throw e;
-        } catch (ParserException &e) {
             reader.setCursor(start);
-            throw e;
         }
+        auto result = tryExecute<R>(source, reader);
+        span.close(result, reader);
+        return result;
+    }
+
+    /**
+     * @brief Parse the arguments of this node and execute its callback, without looking at its children
+     *
+     * @param source The source of the command
+     * @param reader The reader, placed after the name of this node
+     * @return Result<void>
+     */
+    Result<void> tryExecute(TypeHolder &source, Reader &reader) const override { return tryExecute<Reader>(source, reader); }
+
+    /**
+     * @see CommandNode::tryExecute
+     */
+    Result<void> tryExecute(TypeHolder &source, StringViewReader &reader) const override { return tryExecute<StringViewReader>(source, reader); }
+
+    /**
+     * @see CommandNode::tryExecute
+     */
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    Result<void> tryExecute(TypeHolder &source, R &reader) const
+    {
+        if (_redirect) {
+            auto bound = tryBind<R>(reader);
+            if (!bound)
+                return bound.error();
+            (*bound)->execute(source);
+            return {};
+        }
+        if (_callback == nullptr) {
+            _counters.add(_util::NodeCounters::Failures);
+            return ParseError {ErrorCode::InvalidCommand, reader.getCursor()};
+        }
+        _util::Stopwatch stopwatch;
+        auto arguments = _util::tryParseArguments<Parsers...>(reader);
+        _counters.recordParse(stopwatch.lap());
+        if (!arguments) {
+            _counters.add(_util::NodeCounters::Failures);
+            return arguments.error();
+        }
+        std::apply(
+            [&](auto &...args) {
+                _callback(source, std::move(args)...);
+            },
+            *arguments
+        );
+        _counters.recordExecute(stopwatch.lap());
+        return {};
+    }
+
+    /**
+     * @brief Parse the arguments of this node and bind them to its callback, without executing it
+     *
+     * @param reader The reader, placed after the name of this node
+     * @return Result<std::unique_ptr<BoundArguments>>
+     */
+    Result<std::unique_ptr<BoundArguments>> tryBind(Reader &reader) const override { return tryBind<Reader>(reader); }
+
+    /**
+     * @see CommandNode::tryBind
+     */
+    Result<std::unique_ptr<BoundArguments>> tryBind(StringViewReader &reader) const override { return tryBind<StringViewReader>(reader); }
+
+    /**
+     * @see CommandNode::tryBind
+     */
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    Result<std::unique_ptr<BoundArguments>> tryBind(R &reader) const
+    {
+        if (_callback == nullptr && !_redirect) {
+            _counters.add(_util::NodeCounters::Failures);
+            return ParseError {ErrorCode::InvalidCommand, reader.getCursor()};
+        }
+        _util::Stopwatch stopwatch;
+        auto arguments = _util::tryParseArguments<Parsers...>(reader);
+        _counters.recordParse(stopwatch.lap());
+        if (!arguments) {
+            _counters.add(_util::NodeCounters::Failures);
+            return arguments.error();
+        }
+        if (_redirect) {
+            // The rest of the input is parsed once, whatever the number of sources it runs for
+            reader.skipWhitespace();
+            std::shared_ptr<const ICommandNode> owner;
+            auto target = _redirect->resolve(owner);
+            if (target == nullptr) {
+                _counters.add(_util::NodeCounters::Failures);
+                return ParseError {ErrorCode::UnknownCommand, reader.getCursor()};
+            }
+            auto continuation = _util::bindFrom(*target, reader, owner);
+            if (!continuation)
+                return continuation.error();
+            return std::unique_ptr<BoundArguments>(std::make_unique<RedirectCall>(*this, std::move(*arguments), std::move(*continuation), std::move(owner)));
+        }
+        return std::unique_ptr<BoundArguments>(std::make_unique<BoundCall>(*this, std::move(*arguments)));
+    }
+
+    /**
+     * @brief Parse and execute the command
+     *
+     * @throw CommandSyntaxException If the command is invalid
+     *
+     * @param source The source of the command
+     * @param reader The reader to parse the command from
+     */
+    void parse(TypeHolder &source, Reader &reader) const override { parse<Reader>(source, reader); }
+
+    /**
+     * @see CommandNode::parse
+     */
+    void parse(TypeHolder &source, StringViewReader &reader) const override { parse<StringViewReader>(source, reader); }
+
+    /**
+     * @see CommandNode::tryParse
+     */
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    void parse(TypeHolder &source, R &reader) const
+    {
+        valueOrThrow(tryParse<R>(source, reader), reader);
     }
 
     /**
@@ -100,6 +242,14 @@ public:
      */
     const std::vector<std::shared_ptr<ICommandNode>> &getChildren() const override { return _children; }
 
+    /**
+     * @brief Find a child by name or alias
+     *
+     * @param name
+     * @return const ICommandNode*
+     */
+    const ICommandNode *findChild(std::string_view name) const override { return _index.find(name); }
+
     /**
      * @brief Get the Name object
      *
@@ -120,66 +270,197 @@ public:
      * @param source
      * @return bool
      */
-    bool canUse(const TypeHolder &source) override { return _permissionPredicate(source); }
+    bool canUse(const TypeHolder &source) const override
+    {
+        if (_permissionPredicate == nullptr || _permissionPredicate(source))
+            return true;
+        _counters.add(_util::NodeCounters::PermissionDenials);
+        return false;
+    }
 
     /**
-     * @brief Check if the input is valid
+     * @brief Check that the whole input is a valid command, without executing it
      *
      * @param reader
-     * @return bool
+     * @return Result<void>
+     */
+    Result<void> tryValidate(Reader &reader) const override { return tryValidate<Reader>(reader); }
+
+    /**
+     * @see CommandNode::tryValidate
      */
-    bool isValidInput(Reader &reader) const override
+    Result<void> tryValidate(StringViewReader &reader) const override { return tryValidate<StringViewReader>(reader); }
+
+    /**
+     * @brief Check that the whole input is a valid command with a statically known reader
+     *
+     * @tparam R The reader type, calls to its `final` members get inlined
+     * @param reader
+     * @return Result<void>
+     */
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    Result<void> tryValidate(R &reader) const
     {
         auto start = reader.getCursor();
-        std::cout << "isValidInput " << reader.getRemaining() << " " << std::boolalpha << reader.canRead() << std::endl;
-        try {
-            if (reader.canRead()) {
-                auto entry = reader.readString();
-                for (auto &child : _children) {
-                    if (child->getName() == entry)
-                        return true;
-                    if (std::find(child->getAliases().begin(), child->getAliases().end(), entry) != child->getAliases().end())
-                        return true;
-                    if (child->isValidInput(reader))
-                        return true;
-                }
+        if (mayReadChild(reader)) {
+            auto entry = reader.tryReadStringView();
+            if (auto child = entry ? _index.find(*entry) : nullptr) {
+                auto result = child->tryValidate(reader);
                 reader.setCursor(start);
+                return result;
             }
-            if (_callback == nullptr)
-                return false;
-            (Parsers::parse(reader), ...);
+            reader.setCursor(start);
+        }
+        return tryValidateArguments<R>(reader);
+    }
+
+    /**
+     * @brief Check that the rest of the input holds exactly the arguments of this node, without looking at its children
+     *
+     * @param reader The reader, placed after the name of this node, its cursor is left untouched
+     * @return Result<void>
+     */
+    Result<void> tryValidateArguments(Reader &reader) const override { return tryValidateArguments<Reader>(reader); }
+
+    /**
+     * @see CommandNode::tryValidateArguments
+     */
+    Result<void> tryValidateArguments(StringViewReader &reader) const override { return tryValidateArguments<StringViewReader>(reader); }
+
+    /**
+     * @see CommandNode::tryValidateArguments
+     */
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    Result<void> tryValidateArguments(R &reader) const
+    {
+        auto start = reader.getCursor();
+        if (_callback == nullptr && !_redirect)
+            return ParseError {ErrorCode::InvalidCommand, start};
+        auto arguments = _util::tryValidateArguments<Parsers...>(reader);
+        if (!arguments)
+            return arguments;
+        if (_redirect) {
             reader.skipWhitespace();
-            std::cout << reader.getRemainingLength() << std::endl;
-            std::cout << reader.canRead() << std::endl;
-            return reader.getRemainingLength() == 0;
-        } catch (CommandSyntaxException &e) {
-        } catch (ReaderException &e) {
-        } catch (ParserException &e) {
+            std::shared_ptr<const ICommandNode> owner;
+            auto target = _redirect->resolve(owner);
+            Result<void> result = ParseError {ErrorCode::UnknownCommand, reader.getCursor()};
+            if (target)
+                result = target->tryValidate(reader);
+            reader.setCursor(start);
+            return result;
         }
+        reader.skipWhitespace();
+        auto end = reader.getCursor();
         reader.setCursor(start);
-        return false;
+        if (end != reader.getTotalLength())
+            return ParseError {ErrorCode::ExpectedEndOfCommand, end};
+        return {};
     }
 
     /**
-     * @brief List all the suggestions for the input
+     * @brief Check if the input is valid
+     *
+     * @param reader
+     * @return bool
+     */
+    bool isValidInput(Reader &reader) const override { return tryValidate<Reader>(reader).hasValue(); }
+
+    /**
+     * @see CommandNode::isValidInput
+     */
+    bool isValidInput(StringViewReader &reader) const override { return tryValidate<StringViewReader>(reader).hasValue(); }
+
+    /**
+     * @see CommandNode::tryValidate
+     */
+    template<is_reader R>
+        requires(is_parser<Parsers, R> && ...)
+    bool isValidInput(R &reader) const
+    {
+        return tryValidate<R>(reader).hasValue();
+    }
+
+    using ICommandNode::listSuggestions;
+    using ICommandNode::suggestArguments;
+
+    /**
+     * @brief Stream the suggestions for the input into a builder
      *
      * @param holder
      * @param reader
-     * @return std::vector<std::string>
+     * @param builder
      */
-    std::vector<std::string> listSuggestions(TypeHolder &holder, Reader &reader) const override
+    void listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const override
     {
-        auto name = reader.readString();
-        for (auto &child : _children) {
-            if (child->getName() == name || std::find(child->getAliases().begin(), child->getAliases().end(), name) != child->getAliases().end())
-                return child->listSuggestions(holder, reader);
+        auto start = reader.getCursor();
+        auto name = reader.tryReadStringView();
+        if (auto child = name ? _index.find(*name) : nullptr)
+            return child->listSuggestions(holder, reader, builder);
+        reader.setCursor(start);
+        _counters.add(_util::NodeCounters::Suggestions);
+        suggestChildren(holder, reader, builder);
+        suggestArguments(holder, reader, builder);
+    }
+
+    /**
+     * @brief Stream the suggestions of this node once its arguments are parsed, without looking at its children
+     *
+     * @param holder
+     * @param reader The reader, placed after the name of this node
+     * @param builder
+     */
+    void suggestArguments(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const override
+    {
+        if (!_util::tryValidateArguments<Parsers...>(reader))
+            return;
+        // Once the arguments are followed by whitespace, the input continues at the target
+        auto cursor = reader.getCursor();
+        if (_redirect && cursor > 0 && reader.isSpace(reader.getStringView()[cursor - 1])) {
+            std::shared_ptr<const ICommandNode> owner;
+            if (auto target = _redirect->resolve(owner))
+                target->listSuggestions(holder, reader, builder);
+            return;
         }
-        try {
-            reader.setCursor(reader.getCursor() - name.size());
-            (Parsers::parse(reader), ...);
-            return _suggestionProvider(holder);
-        } catch (CommandSyntaxException &e) {
-            return {};
+        provideSuggestions(holder, builder);
+    }
+
+    void suggestChildren(const TypeHolder &holder, const Reader &reader, SuggestionsBuilder &builder) const override
+    {
+        _util::suggestLiterals(_index, holder, reader, builder);
+    }
+
+    /**
+     * @brief Get the number of arguments, 0 for redirect nodes which are suggested from their start
+     *
+     * @return size_t
+     */
+    size_t getArgumentCount() const override { return _redirect ? 0 : sizeof...(Parsers); }
+
+    /**
+     * @brief Move the reader past the argument at index, without building it
+     *
+     * @param index
+     * @param reader
+     * @return Result<void>
+     */
+    Result<void> tryValidateArgument(size_t index, Reader &reader) const override
+    {
+        Result<void> result = ParseError {ErrorCode::InvalidArgument, reader.getCursor()};
+        size_t i = 0;
+        // Cast, the fold is a lone false without arguments
+        (void)((i++ == index && (result = _util::tryValidateArgument<Parsers>(reader), true)) || ...);
+        return result;
+    }
+
+    void provideSuggestions(TypeHolder &holder, SuggestionsBuilder &builder) const override
+    {
+        if (_suggestionProvider) {
+            // No cursor here, the range is the number of suggestions before and after
+            _util::TraceSpan span("suggestions", builder.getCount(), [this] { return _name; });
+            _suggestionProvider(holder, builder);
+            span.close(builder.getCount(), ErrorCode::None);
         }
     }
 
@@ -190,7 +471,42 @@ public:
      */
     const std::vector<std::string> &getAliases() const override { return _aliases; }
 
+    _util::Counters *getCounters() const override { return &_counters; }
+
+    /**
+     * @brief Whether the first argument of this node accepts the whole token
+     *
+     * @param token
+     * @return bool
+     */
+    bool acceptsArgument(std::string_view token) const override
+    {
+        if constexpr (sizeof...(Parsers) == 0) {
+            return false;
+        } else {
+            using First = std::tuple_element_t<0, std::tuple<Parsers...>>;
+            if ((_callback == nullptr && !_redirect) || token.empty() || !_util::canStartWith<First>(token.front(), standardCharClasses))
+                return false;
+            StringViewReader reader(token);
+            return _util::tryValidateArgument<First>(reader) && !reader.canRead();
+        }
+    }
+
 private:
+    /**
+     * @brief Whether the token at the cursor may name a child, decided on its first character
+     *
+     * Otherwise the token is left to the arguments without being read nor looked up.
+     */
+    template<is_reader R>
+    bool mayReadChild(const R &reader) const
+    {
+        if (!reader.canRead())
+            return false;
+        auto c = reader.peek();
+        return _index.startsAKey(c) || (_index.size() != 0 && reader.isQuotedStringStart(c));
+    }
+
     /**
      * @brief Construct a new Command Node object
      *
@@ -198,14 +514,80 @@ private:
      */
     CommandNode() = delete;
 
+    /**
+     * @brief The parsed arguments of the node, see `tryBind`
+     */
+    class BoundCall final : public BoundArguments {
+    public:
+        BoundCall(const CommandNode &node, std::tuple<typename Parsers::type...> &&arguments):
+            _node(node),
+            _arguments(std::move(arguments))
+        {
+        }
+
+        void execute(TypeHolder &source) const override
+        {
+            _util::Stopwatch stopwatch;
+            // Copied, the results may be executed again
+            std::apply(
+                [&](const auto &...args) {
+                    _node._callback(source, typename Parsers::type(args)...);
+                },
+                _arguments
+            );
+            _node._counters.recordExecute(stopwatch.lap());
+        }
+
+    private:
+        const CommandNode &_node;
+        const std::tuple<typename Parsers::type...> _arguments;
+    };
+
+    /**
+     * @brief The parsed arguments of a redirect node, followed by the bound rest of the input
+     */
+    class RedirectCall final : public BoundArguments {
+    public:
+        RedirectCall(const CommandNode &node, std::tuple<typename Parsers::type...> &&arguments, std::unique_ptr<BoundArguments> continuation, std::shared_ptr<const ICommandNode> owner):
+            _node(node),
+            _arguments(std::move(arguments)),
+            _continuation(std::move(continuation)),
+            _owner(std::move(owner))
+        {
+        }
+
+        void execute(TypeHolder &source) const override
+        {
+            auto &redirect = *_node._redirect;
+            if (redirect.fork == nullptr)
+                return _continuation->execute(source);
+            auto sources = std::apply(
+                [&](const auto &...args) {
+                    return redirect.fork(source, typename Parsers::type(args)...);
+                },
+                _arguments
+            );
+            _util::forEachSource(sources, *_continuation, redirect.executor, redirect.parallelThreshold);
+        }
+
+    private:
+        const CommandNode &_node;
+        const std::tuple<typename Parsers::type...> _arguments;
+        const std::unique_ptr<BoundArguments> _continuation;
+        const std::shared_ptr<const ICommandNode> _owner; // Keeps the nodes of the continuation alive
+    };
+
 private:
     const std::string_view _name;
     const std::string_view _description;
     const std::vector<Argument> _arguments;
     const std::vector<std::string> _aliases;
     const std::vector<std::shared_ptr<ICommandNode>> _children;
-    const std::function<bool(const TypeHolder &)> _permissionPredicate;
-    const std::function<void(TypeHolder &, typename Parsers::type...)> _callback;
-    const std::function<std::vector<std::string>(TypeHolder &)> _suggestionProvider;
+    const _util::ChildIndex _index;
+    const Function<bool(const TypeHolder &)> _permissionPredicate;
+    const Function<void(TypeHolder &, typename Parsers::type...)> _callback;
+    const Function<void(TypeHolder &, SuggestionsBuilder &)> _suggestionProvider;
+    const std::unique_ptr<const _util::Redirect<typename Parsers::type...>> _redirect;
+    [[no_unique_address]] mutable _util::Counters _counters;
 };
 } // namespace brigadier
@@ -58,10 +58,12 @@ public:
         _name(name),
         _description(description),
         _children(),
+        _index(),
         _aliases(),
         _permissionPredicate(),
         _callback(),
-        _suggestionProvider()
+        _suggestionProvider(),
+        _redirect()
     {
         static_assert(sizeof...(_Parsers) == 0, "Don't provide parsers to the CommandNodeBuilder, use expectArg");
     }
@@ -102,12 +104,71 @@ public:
      * @param callback
      * @return CommandNodeBuilder&
      */
-    CommandNodeBuilder &execute(std::function<void(TypeHolder &, typename _Parsers::type...)> callback)
+    CommandNodeBuilder &execute(Function<void(TypeHolder &, typename _Parsers::type...)> callback)
     {
         _callback = std::move(callback);
         return *this;
     }
 
+    /**
+     * @brief Send the rest of the input to another node once the arguments are parsed, instead of executing a callback
+     *
+     * The target may be an ancestor of this node or a registry, the path names the literals to follow from it:
+     *
+     * @code
+     * CommandNodeBuilder("execute")
+     *     .add(CommandNodeBuilder("at").expectArg<StringParser>("position").redirect(registry, "execute")) // chain subcommands
+     *     .add(CommandNodeBuilder("run").redirect(registry)); // any command
+     * @endcode
+     *
+     * @warning The target must outlive the node, and a redirect must read some input before it comes back to its own node
+     *
+     * @param target
+     * @param path Literals separated by spaces
+     * @return CommandNodeBuilder&
+     */
+    CommandNodeBuilder &redirect(const ICommandNode &target, std::string_view path = "")
+    {
+        _redirect = std::make_unique<_util::Redirect<typename _Parsers::type...>>();
+        _redirect->target = &target;
+        _redirect->path = _util::splitPath(path);
+        return *this;
+    }
+
+    /**
+     * @brief Redirect the rest of the input, executing it once for each source returned by the fork
+     *
+     * The rest of the input is parsed once, then executed for each source: `execute as @a run give ...` does not
+     * parse `give` again per player. From parallelThreshold sources on, they are run by the executor; all of them
+     * run even if some throw, and the exception of the first that threw, in the order of the sources, is rethrown.
+     *
+     * @code
+     * CommandNodeBuilder("as")
+     *     .expectArg<StringParser>("targets")
+     *     .fork(registry, "execute", [&](TypeHolder &, std::string targets) { return world.select(targets); }, &dispatcher);
+     * @endcode
+     *
+     * @see CommandNodeBuilder::redirect
+     *
+     * @param target
+     * @param path Literals separated by spaces
+     * @param fork Returns the sources, the callbacks of the rest of the input may use them from several threads at once
+     * @param executor nullptr to always run the sources in order on the calling thread
+     * @param parallelThreshold
+     * @return CommandNodeBuilder&
+     */
+    CommandNodeBuilder &fork(
+        const ICommandNode &target, std::string_view path, Function<std::vector<TypeHolder>(TypeHolder &, typename _Parsers::type...)> fork, Executor *executor = nullptr,
+        size_t parallelThreshold = 64
+    )
+    {
+        redirect(target, path);
+        _redirect->fork = std::move(fork);
+        _redirect->executor = executor;
+        _redirect->parallelThreshold = parallelThreshold;
+        return *this;
+    }
+
     /**
      * @brief Add an alias to the command node
      *
@@ -126,7 +187,7 @@ public:
      * @param permissionPredicate
      * @return CommandNodeBuilder&
      */
-    CommandNodeBuilder &withPermission(std::function<bool(const TypeHolder &)> permissionPredicate)
+    CommandNodeBuilder &withPermission(Function<bool(const TypeHolder &)> permissionPredicate)
     {
         _permissionPredicate = std::move(permissionPredicate);
         return *this;
@@ -140,6 +201,7 @@ public:
      */
     CommandNodeBuilder &add(std::shared_ptr<ICommandNode> child)
     {
+        _index.add(child);
         _children.emplace_back(std::move(child));
         return *this;
     }
@@ -147,23 +209,53 @@ public:
     /**
      * @brief Set the suggestion provider
      *
+     * The provider streams its candidates into the builder and may stop as soon as `suggest` returns false.
+     *
      * @param suggestionProvider
      * @return CommandNodeBuilder&
      */
-    CommandNodeBuilder &suggestionBuilder(std::function<std::vector<std::string>(TypeHolder &)> suggestionProvider)
+    CommandNodeBuilder &suggestionBuilder(Function<void(TypeHolder &, SuggestionsBuilder &)> suggestionProvider)
     {
         _suggestionProvider = std::move(suggestionProvider);
         return *this;
     }
 
+    /**
+     * @brief Set a suggestion provider returning all its candidates at once
+     *
+     * @param suggestionProvider
+     * @return CommandNodeBuilder&
+     */
+    CommandNodeBuilder &suggestionBuilder(Function<std::vector<std::string>(TypeHolder &)> suggestionProvider)
+    {
+        _suggestionProvider = [suggestionProvider = std::move(suggestionProvider)](TypeHolder &holder, SuggestionsBuilder &builder) {
+            for (auto &suggestion : suggestionProvider(holder)) {
+                if (!builder.suggest(suggestion))
+                    break;
+            }
+        };
+        return *this;
+    }
+
     /**
      * @brief Build the command node
      *
+     * The callbacks are moved into the node: a builder builds a single node.
+     *
+     * @throw BuilderException If the builder, or the one it was made from by `expectArg`, already built its node
+     *
      * @return std::shared_ptr<ICommandNode>
      */
-    std::shared_ptr<ICommandNode> build() const
+    std::shared_ptr<ICommandNode> build()
     {
-        return std::make_shared<CommandNode<_Parsers...>>(_name, _description, _arguments, _children, _aliases, _permissionPredicate, _callback, _suggestionProvider);
+        if (_built)
+            throw BuilderException(fmt::format("The node {} is already built", _name));
+        _built = true;
+        _index.sortKeys();
+        return std::make_shared<CommandNode<_Parsers...>>(
+            _name, _description, _arguments, _children, _index, _aliases, std::move(_permissionPredicate), std::move(_callback), std::move(_suggestionProvider),
+            std::move(_redirect)
+        );
     }
 
     /**
@@ -171,7 +263,7 @@ public:
      *
      * @return std::shared_ptr<ICommandNode>
      */
-    operator std::shared_ptr<ICommandNode>() const { return build(); }
+    operator std::shared_ptr<ICommandNode>() { return build(); }
 
 private:
     /**
@@ -184,15 +276,18 @@ private:
      * @param argument
      */
     template<typename... Args>
-    CommandNodeBuilder(const CommandNodeBuilder<Args...> &builder, const Argument &argument):
+    CommandNodeBuilder(CommandNodeBuilder<Args...> &builder, const Argument &argument):
         _name(builder._name),
         _description(builder._description),
         _arguments(std::move(builder._arguments)),
         _children(std::move(builder._children)),
+        _index(std::move(builder._index)),
         _aliases(std::move(builder._aliases)),
         _permissionPredicate(std::move(builder._permissionPredicate)),
         _callback(),
-        _suggestionProvider(std::move(builder._suggestionProvider))
+        _suggestionProvider(std::move(builder._suggestionProvider)),
+        _redirect(),
+        _built(builder._built)
     {
         this->_arguments.emplace_back(argument);
     }
@@ -202,9 +297,12 @@ private:
     const std::string_view _description;
     std::vector<Argument> _arguments;
     std::vector<std::shared_ptr<ICommandNode>> _children;
+    _util::ChildIndex _index;
     std::vector<std::string> _aliases;
-    std::function<bool(const TypeHolder &)> _permissionPredicate;
-    std::function<void(TypeHolder &, typename _Parsers::type...)> _callback;
-    std::function<std::vector<std::string>(TypeHolder &)> _suggestionProvider;
+    Function<bool(const TypeHolder &)> _permissionPredicate;
+    Function<void(TypeHolder &, typename _Parsers::type...)> _callback;
+    Function<void(TypeHolder &, SuggestionsBuilder &)> _suggestionProvider;
+    std::unique_ptr<_util::Redirect<typename _Parsers::type...>> _redirect;
+    bool _built = false;
 };
 } // namespace brigadier
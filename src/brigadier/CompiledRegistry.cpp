@@ -0,0 +1,223 @@
+#include <brigadier/ChildIndex.hpp>
+#include <brigadier/CompiledRegistry.hpp>
+#include <brigadier/Registry.hpp>
+#include <brigadier/exceptions.hpp>
+#include <bit>
+#include <unordered_map>
+
+brigadier::CompiledRegistry::CompiledRegistry(const Registry &registry):
+    CompiledRegistry(registry.getSnapshot())
+{
+}
+
+brigadier::CompiledRegistry::CompiledRegistry(std::vector<std::shared_ptr<ICommandNode>> roots):
+    _roots(std::move(roots))
+{
+    _rootIndex.addAll(_roots);
+
+    std::unordered_map<std::string_view, StringId> interned;
+    std::unordered_map<const ICommandNode *, NodeId> ids;
+    std::vector<const std::vector<std::shared_ptr<ICommandNode>> *> children;
+    std::vector<std::pair<StringId, NodeId>> keys;
+
+    auto intern = [&](std::string_view str) {
+        auto [it, inserted] = interned.try_emplace(str, static_cast<StringId>(_strings.size()));
+        if (inserted) {
+            _strings.push_back({static_cast<uint32_t>(_chars.size()), static_cast<uint32_t>(str.size())});
+            _chars.append(str);
+        }
+        return it->second;
+    };
+
+    _nodes.push_back({nullptr, intern(""), 0, 0, 0, 0, 0});
+    children.push_back(&_roots);
+    // Breadth-first, so that siblings get contiguous ids
+    for (NodeId id = 0; id < _nodes.size(); ++id) {
+        keys.clear();
+        for (auto &child : *children[id]) {
+            auto [it, inserted] = ids.try_emplace(child.get(), static_cast<NodeId>(_nodes.size()));
+            if (inserted) {
+                auto aliases = static_cast<uint32_t>(_aliases.size());
+                for (auto &alias : child->getAliases())
+                    _aliases.push_back(intern(alias));
+                _nodes.push_back({child.get(), intern(child->getName()), 0, 0, 0, aliases, static_cast<uint32_t>(_aliases.size()) - aliases});
+                children.push_back(&child->getChildren());
+            }
+            auto &node = _nodes[it->second];
+            keys.emplace_back(node.name, it->second);
+            for (auto alias : getAliases(it->second))
+                keys.emplace_back(alias, it->second);
+        }
+
+        auto &node = _nodes[id];
+        node.edges = static_cast<uint32_t>(_edges.size());
+        node.edgeMask = keys.empty() ? 0 : static_cast<uint32_t>(std::bit_ceil(keys.size() * 2)) - 1;
+        node.edgeCount = 0;
+        if (keys.empty())
+            continue;
+        _edges.resize(_edges.size() + node.edgeMask + 1);
+        for (auto [key, target] : keys) {
+            auto name = getString(key);
+            // The first node registered under a name wins, as in Registry
+            if (find(id, name) != npos)
+                continue;
+            auto hash = _util::hashName(name);
+            auto i = hash & node.edgeMask;
+            while (_edges[node.edges + i].target != npos)
+                i = (i + 1) & node.edgeMask;
+            _edges[node.edges + i] = {hash, key, target};
+            ++node.edgeCount;
+        }
+    }
+}
+
+brigadier::CompiledRegistry::NodeId brigadier::CompiledRegistry::find(NodeId parent, std::string_view name) const
+{
+    auto &node = _nodes[parent];
+    if (node.edgeCount == 0)
+        return npos;
+    auto hash = _util::hashName(name);
+    for (auto i = hash & node.edgeMask;; i = (i + 1) & node.edgeMask) {
+        auto &edge = _edges[node.edges + i];
+        if (edge.target == npos)
+            return npos;
+        if (edge.hash == hash && getString(edge.key) == name)
+            return edge.target;
+    }
+}
+
+/**
+ * Walk the literals of the input down the tree, stopping at the first token which is not a child.
+ * nodeStart is set to where the arguments of the resolved node start, or to the unknown root token.
+ */
+template<brigadier::is_reader R>
+brigadier::CompiledRegistry::NodeId brigadier::CompiledRegistry::resolve(R &reader, size_t &nodeStart) const
+{
+    reader.skipWhitespace();
+    nodeStart = reader.getCursor();
+    auto cmd = reader.tryReadStringView();
+    auto node = cmd ? find(root, *cmd) : npos;
+    if (node == npos)
+        return npos;
+    while (true) {
+        nodeStart = reader.getCursor();
+        if (!reader.canRead())
+            return node;
+        auto entry = reader.tryReadStringView();
+        auto child = entry ? find(node, *entry) : npos;
+        if (child == npos) {
+            reader.setCursor(nodeStart);
+            return node;
+        }
+        node = child;
+    }
+}
+
+template<brigadier::is_reader R>
+brigadier::Result<void> brigadier::CompiledRegistry::tryParseImpl(TypeHolder &source, R &reader) const
+{
+    auto start = reader.getCursor();
+    size_t nodeStart;
+    auto node = resolve(reader, nodeStart);
+    if (node == npos) {
+        reader.setCursor(start);
+        return ParseError {ErrorCode::UnknownCommand, nodeStart};
+    }
+    auto result = _nodes[node].impl->tryExecute(source, reader);
+    if (!result)
+        reader.setCursor(start);
+    return result;
+}
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryParse(std::string_view command) const
+{
+    TypeHolder holder;
+    Tokens tokens;
+    StringViewReader reader(command);
+    reader.setTokens(&tokens);
+    return tryParseImpl(holder, reader);
+}
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryParse(TypeHolder holder, std::string_view command) const
+{
+    Tokens tokens;
+    StringViewReader reader(command);
+    reader.setTokens(&tokens);
+    return tryParseImpl(holder, reader);
+}
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryParse(TypeHolder &source, Reader &reader) const { return tryParseImpl(source, reader); }
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryParse(TypeHolder &source, StringViewReader &reader) const { return tryParseImpl(source, reader); }
+
+void brigadier::CompiledRegistry::parse(std::string_view command) const
+{
+    TypeHolder holder;
+    Tokens tokens;
+    StringViewReader reader(command);
+    reader.setTokens(&tokens);
+    parse(holder, reader);
+}
+
+void brigadier::CompiledRegistry::parse(TypeHolder holder, std::string_view command) const
+{
+    Tokens tokens;
+    StringViewReader reader(command);
+    reader.setTokens(&tokens);
+    parse(holder, reader);
+}
+
+void brigadier::CompiledRegistry::parse(TypeHolder &source, Reader &reader) const { valueOrThrow(tryParseImpl(source, reader), reader); }
+
+void brigadier::CompiledRegistry::parse(TypeHolder &source, StringViewReader &reader) const { valueOrThrow(tryParseImpl(source, reader), reader); }
+
+template<brigadier::is_reader R>
+brigadier::Result<void> brigadier::CompiledRegistry::tryValidateImpl(R &input) const
+{
+    auto start = input.getCursor();
+    size_t nodeStart;
+    auto node = resolve(input, nodeStart);
+    if (node == npos) {
+        input.setCursor(start);
+        return ParseError {ErrorCode::UnknownCommand, nodeStart};
+    }
+    auto result = _nodes[node].impl->tryValidateArguments(input);
+    input.setCursor(start);
+    return result;
+}
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryValidate(std::string_view input) const
+{
+    Tokens tokens;
+    StringViewReader reader(input);
+    reader.setTokens(&tokens);
+    return tryValidateImpl(reader);
+}
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryValidate(Reader &input) const { return tryValidateImpl(input); }
+
+brigadier::Result<void> brigadier::CompiledRegistry::tryValidate(StringViewReader &input) const { return tryValidateImpl(input); }
+
+bool brigadier::CompiledRegistry::isValidInput(std::string_view input) const { return tryValidate(input).hasValue(); }
+
+bool brigadier::CompiledRegistry::isValidInput(Reader &input) const { return tryValidateImpl(input).hasValue(); }
+
+bool brigadier::CompiledRegistry::isValidInput(StringViewReader &input) const { return tryValidateImpl(input).hasValue(); }
+
+std::vector<std::string> brigadier::CompiledRegistry::listSuggestions(TypeHolder &holder, Reader &reader) const
+{
+    std::vector<std::string> suggestions;
+    SuggestionsBuilder builder(suggestions);
+    listSuggestions(holder, reader, builder);
+    return suggestions;
+}
+
+void brigadier::CompiledRegistry::listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const
+{
+    size_t nodeStart;
+    auto node = resolve(reader, nodeStart);
+    if (node != npos)
+        return _nodes[node].impl->listSuggestions(holder, reader, builder);
+    reader.setCursor(nodeStart);
+    _util::suggestLiterals(_rootIndex, holder, reader, builder);
+}
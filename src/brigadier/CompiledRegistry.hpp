@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <brigadier/ChildIndex.hpp>
+#include <brigadier/ICommandNode.hpp>
+#include <brigadier/Result.hpp>
+#include <brigadier/SuggestionsBuilder.hpp>
+#include <brigadier/TypeHolder.hpp>
+#include <brigadier/reader/Reader.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
+
+namespace brigadier {
+class Registry;
+
+/**
+ * @brief An immutable snapshot of a `Registry`, laid out for dispatch
+ *
+ * The command tree is flattened into contiguous arrays indexed by 32-bit ids:
+ * nodes, edges (one open-addressing table per node, keyed by name and alias),
+ * interned strings and aliases. Resolving a command walks these arrays and only calls
+ * into the original nodes to parse the arguments of the node it resolved to.
+ *
+ * Build it once the tree is complete with `Registry::freeze()`, nodes added to the
+ * registry afterwards are not visible to it.
+ *
+ * @code
+ * auto compiled = registry.freeze();
+ * compiled.parse(source, "give steve 64");
+ * @endcode
+ */
+class CompiledRegistry {
+public:
+    using NodeId = uint32_t;
+    using StringId = uint32_t;
+
+    static constexpr NodeId root = 0;
+    static constexpr NodeId npos = std::numeric_limits<NodeId>::max();
+
+    /**
+     * @brief Compile the tree of a registry
+     *
+     * @param registry
+     */
+    explicit CompiledRegistry(const Registry &registry);
+
+    /**
+     * @brief Compile a tree from its root commands
+     *
+     * @param roots
+     */
+    explicit CompiledRegistry(std::vector<std::shared_ptr<ICommandNode>> roots);
+
+    Result<void> tryParse(std::string_view command) const;
+    Result<void> tryParse(TypeHolder holder, std::string_view command) const;
+
+    /**
+     * @brief Parse a command and execute it, without throwing on invalid input
+     *
+     * @see Registry::tryParse
+     */
+    Result<void> tryParse(TypeHolder &source, Reader &reader) const;
+    Result<void> tryParse(TypeHolder &source, StringViewReader &reader) const;
+
+    void parse(std::string_view command) const;
+    void parse(TypeHolder holder, std::string_view command) const;
+
+    /**
+     * @brief Parse a command and execute it
+     *
+     * @throw CommandSyntaxException If the command is invalid
+     */
+    void parse(TypeHolder &source, Reader &reader) const;
+    void parse(TypeHolder &source, StringViewReader &reader) const;
+
+    /**
+     * @brief Check that the input is a valid command without executing it
+     *
+     * @see Registry::tryValidate
+     */
+    Result<void> tryValidate(std::string_view input) const;
+    Result<void> tryValidate(Reader &input) const;
+    Result<void> tryValidate(StringViewReader &input) const;
+
+    bool isValidInput(std::string_view input) const;
+    bool isValidInput(Reader &input) const;
+    bool isValidInput(StringViewReader &input) const;
+
+    [[nodiscard]] std::vector<std::string> listSuggestions(TypeHolder &holder, Reader &reader) const;
+
+    /**
+     * @see Registry::listSuggestions
+     */
+    void listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const;
+
+    /**
+     * @brief Find the child of a node by name or alias
+     *
+     * @param parent
+     * @param name
+     * @return NodeId `npos` if there is none
+     */
+    NodeId find(NodeId parent, std::string_view name) const;
+
+    /**
+     * @brief Get the number of nodes, the root included
+     *
+     * @return size_t
+     */
+    size_t size() const { return _nodes.size(); }
+
+    std::string_view getName(NodeId node) const { return getString(_nodes[node].name); }
+    std::span<const StringId> getAliases(NodeId node) const { return std::span(_aliases).subspan(_nodes[node].aliases, _nodes[node].aliasCount); }
+    std::string_view getString(StringId id) const { return std::string_view(_chars).substr(_strings[id].offset, _strings[id].length); }
+
+    /**
+     * @brief Get the node the id was compiled from
+     *
+     * @return const ICommandNode* nullptr for the root
+     */
+    const ICommandNode *getNode(NodeId node) const { return _nodes[node].impl; }
+
+private:
+    struct Node {
+        const ICommandNode *impl;
+        StringId name;
+        uint32_t edges; ///< First slot of the edge table of the node
+        uint32_t edgeMask; ///< Size of the edge table minus one, the table is empty if there are no edges
+        uint32_t edgeCount;
+        uint32_t aliases;
+        uint32_t aliasCount;
+    };
+
+    struct Edge {
+        uint32_t hash;
+        StringId key;
+        NodeId target = npos; ///< `npos` for an empty slot
+    };
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    template<is_reader R>
+    NodeId resolve(R &reader, size_t &nodeStart) const;
+
+    template<is_reader R>
+    Result<void> tryParseImpl(TypeHolder &source, R &reader) const;
+
+    template<is_reader R>
+    Result<void> tryValidateImpl(R &input) const;
+
+private:
+    std::vector<Node> _nodes;
+    std::vector<Edge> _edges;
+    std::vector<StringId> _aliases;
+    std::vector<StringRef> _strings;
+    std::string _chars;
+    std::vector<std::shared_ptr<ICommandNode>> _roots; ///< Keeps the compiled nodes alive
+    _util::ChildIndex _rootIndex; ///< Only used to complete partial root commands
+};
+} // namespace brigadier
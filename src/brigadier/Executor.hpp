@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+#include <brigadier/Function.hpp>
+
+namespace brigadier {
+/**
+ * @brief Runs the iterations of a loop, possibly on other threads
+ *
+ * Fork nodes hand it the sources of a command once there are enough of them, see `CommandNodeBuilder::fork`.
+ * `ParallelDispatcher` is one, backed by its workers.
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * @brief Call task with each index in [0, count), in any order and on any thread, blocking until all calls returned
+     *
+     * The calling thread takes part, so a task may itself call forEach on the same executor.
+     *
+     * @param count
+     * @param task Must not throw
+     */
+    virtual void forEach(size_t count, const Function<void(size_t)> &task) = 0;
+};
+} // namespace brigadier
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <brigadier/options.hpp>
+
+namespace brigadier {
+template<typename Signature, size_t Capacity = options::callbackCapacity>
+class Function;
+
+/**
+ * @brief A move-only callable, stored inline when it fits
+ *
+ * Unlike `std::function`, callables up to Capacity bytes (and nothrow movable) are stored inside the object,
+ * larger ones only are allocated. It is never copied, so callables capturing move-only state are accepted.
+ *
+ * Arguments declared by value in the signature are taken as rvalues, and forwarded to the callable
+ * without intermediate copies nor moves: the callable's own parameter is move-constructed once.
+ *
+ * @code
+ * Function<void(TypeHolder &, std::string)> callback = [buffer = std::make_unique<Buffer>()](TypeHolder &, std::string name) { ... };
+ * callback(source, std::move(name));
+ * @endcode
+ *
+ * @tparam R The return type
+ * @tparam Args The parameters
+ * @tparam Capacity The inline storage, in bytes
+ */
+template<typename R, typename... Args, size_t Capacity>
+class Function<R(Args...), Capacity> {
+    static_assert(Capacity >= sizeof(void *), "The storage must at least hold a pointer");
+
+    template<typename F>
+    static constexpr bool fitsInline = sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+public:
+    Function() noexcept = default;
+
+    Function(std::nullptr_t) noexcept {}
+
+    template<typename F>
+        requires(!std::same_as<std::remove_cvref_t<F>, Function> && std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+    Function(F &&f)
+    {
+        using T = std::decay_t<F>;
+        // Null function pointers and empty std::function stay empty
+        if constexpr (std::is_constructible_v<bool, const T &>) {
+            if (!static_cast<bool>(f))
+                return;
+        }
+        if constexpr (fitsInline<T>) {
+            ::new (static_cast<void *>(_storage)) T(std::forward<F>(f));
+            _vtable = &inlineVTable<T>;
+        } else {
+            ::new (static_cast<void *>(_storage)) T *(new T(std::forward<F>(f)));
+            _vtable = &heapVTable<T>;
+        }
+        _invoke = _vtable->invoke;
+    }
+
+    Function(Function &&other) noexcept:
+        _invoke(std::exchange(other._invoke, nullptr)),
+        _vtable(std::exchange(other._vtable, nullptr))
+    {
+        if (_vtable != nullptr)
+            _vtable->move(_storage, other._storage);
+    }
+
+    Function &operator=(Function &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            if (other._vtable != nullptr) {
+                other._vtable->move(_storage, other._storage);
+                _invoke = std::exchange(other._invoke, nullptr);
+                _vtable = std::exchange(other._vtable, nullptr);
+            }
+        }
+        return *this;
+    }
+
+    Function &operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    Function(const Function &) = delete;
+    Function &operator=(const Function &) = delete;
+
+    ~Function() { reset(); }
+
+    explicit operator bool() const noexcept { return _vtable != nullptr; }
+    bool operator==(std::nullptr_t) const noexcept { return _vtable == nullptr; }
+
+    /**
+     * @brief Call the callable, which must not be empty
+     *
+     * Like `std::function`, the callable is called as non-const even through a const `Function`.
+     */
+    R operator()(Args &&...args) const { return _invoke(const_cast<std::byte *>(_storage), std::forward<Args>(args)...); }
+
+private:
+    struct VTable {
+        R (*invoke)(void *, Args &&...);
+        void (*move)(void *to, void *from) noexcept; ///< Move-construct into to and destroy from
+        void (*destroy)(void *) noexcept;
+    };
+
+    template<typename T>
+    static constexpr VTable inlineVTable {
+        [](void *storage, Args &&...args) -> R { return std::invoke(*static_cast<T *>(storage), std::forward<Args>(args)...); },
+        [](void *to, void *from) noexcept {
+            ::new (to) T(std::move(*static_cast<T *>(from)));
+            static_cast<T *>(from)->~T();
+        },
+        [](void *storage) noexcept { static_cast<T *>(storage)->~T(); },
+    };
+
+    template<typename T>
+    static constexpr VTable heapVTable {
+        [](void *storage, Args &&...args) -> R { return std::invoke(**static_cast<T **>(storage), std::forward<Args>(args)...); },
+        [](void *to, void *from) noexcept { ::new (to) T *(*static_cast<T **>(from)); },
+        [](void *storage) noexcept { delete *static_cast<T **>(storage); },
+    };
+
+    void reset() noexcept
+    {
+        _invoke = nullptr;
+        if (_vtable != nullptr)
+            std::exchange(_vtable, nullptr)->destroy(_storage);
+    }
+
+private:
+    alignas(std::max_align_t) std::byte _storage[Capacity];
+    R (*_invoke)(void *, Args &&...) = nullptr; ///< Copied out of the table, calls load one pointer
+    const VTable *_vtable = nullptr;
+};
+} // namespace brigadier
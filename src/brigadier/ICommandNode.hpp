@@ -1,25 +1,186 @@
 #pragma once
 
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include <brigadier/Ambiguity.hpp>
+#include <brigadier/Metrics.hpp>
+#include <brigadier/ParseResults.hpp>
+#include <brigadier/Result.hpp>
+#include <brigadier/SuggestionsBuilder.hpp>
 #include <brigadier/TypeHolder.hpp>
+#include <brigadier/exceptions.hpp>
 #include <brigadier/reader/Reader.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
 
 namespace brigadier {
-class ICommandNode {
+class ICommandNode : public std::enable_shared_from_this<ICommandNode> {
 public:
     virtual ~ICommandNode() = default;
 
-    virtual void parse(TypeHolder &source, Reader &reader) const = 0;
+    /**
+     * @brief Parse and execute the command without throwing on invalid input
+     *
+     * Exceptions thrown by the callback itself are not caught.
+     * On error the cursor of the reader is moved back to where it was.
+     */
+    virtual Result<void> tryParse(TypeHolder &source, Reader &reader) const = 0;
+    virtual Result<void> tryParse(TypeHolder &source, StringViewReader &reader) const { return tryParse(source, static_cast<Reader &>(reader)); }
+
+    /**
+     * @brief Parse the arguments of this node and execute its callback, without looking at its children
+     *
+     * Used by dispatchers that already resolved the node, e.g. `CompiledRegistry`.
+     */
+    virtual Result<void> tryExecute(TypeHolder &source, Reader &reader) const = 0;
+    virtual Result<void> tryExecute(TypeHolder &source, StringViewReader &reader) const { return tryExecute(source, static_cast<Reader &>(reader)); }
+
+    /**
+     * @brief Parse the arguments of this node without executing its callback, without looking at its children
+     *
+     * @see ParseResults
+     */
+    virtual Result<std::unique_ptr<BoundArguments>> tryBind(Reader &reader) const = 0;
+    virtual Result<std::unique_ptr<BoundArguments>> tryBind(StringViewReader &reader) const { return tryBind(static_cast<Reader &>(reader)); }
+    virtual void parse(TypeHolder &source, Reader &reader) const { valueOrThrow(tryParse(source, reader), reader); }
+    virtual void parse(TypeHolder &source, StringViewReader &reader) const { valueOrThrow(tryParse(source, reader), reader); }
     virtual const std::vector<std::shared_ptr<ICommandNode>> &getChildren() const = 0;
+
+    /**
+     * @brief Find a child by name or alias
+     *
+     * @return const ICommandNode* nullptr if there is none
+     */
+    virtual const ICommandNode *findChild(std::string_view name) const = 0;
     virtual std::string_view getName() const = 0;
     virtual std::string_view getUsage() const = 0;
-    virtual bool canUse(const TypeHolder &source) = 0;
-    virtual bool isValidInput(Reader &input) const = 0;
-    virtual std::vector<std::string> listSuggestions(TypeHolder &holder, Reader &reader) const = 0;
+    virtual bool canUse(const TypeHolder &source) const = 0;
+
+    /**
+     * @brief Check that the whole input is a valid command, without executing it
+     *
+     * On error the cursor of the reader is moved back to where it was.
+     */
+    virtual Result<void> tryValidate(Reader &input) const = 0;
+    virtual Result<void> tryValidate(StringViewReader &input) const { return tryValidate(static_cast<Reader &>(input)); }
+
+    /**
+     * @brief Check that the rest of the input holds exactly the arguments of this node, without looking at its children
+     */
+    virtual Result<void> tryValidateArguments(Reader &input) const = 0;
+    virtual Result<void> tryValidateArguments(StringViewReader &input) const { return tryValidateArguments(static_cast<Reader &>(input)); }
+    virtual bool isValidInput(Reader &input) const { return tryValidate(input).hasValue(); }
+    virtual bool isValidInput(StringViewReader &input) const { return tryValidate(input).hasValue(); }
+
+    /**
+     * @brief Stream the suggestions for the input into a builder
+     */
+    virtual void listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const = 0;
+
+    /**
+     * @brief Stream the suggestions of this node once its arguments are parsed, without looking at its children
+     */
+    virtual void suggestArguments(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const = 0;
+
+    /**
+     * @brief Suggest the children completing the token at the cursor, if it is the last one of the input
+     */
+    virtual void suggestChildren(const TypeHolder &holder, const Reader &reader, SuggestionsBuilder &builder) const {}
+
+    /**
+     * @brief Stepwise validation of the arguments, used to resume parsing in the middle of a node
+     *
+     * Nodes not supporting it report no arguments, and are resumed from their start.
+     */
+    virtual size_t getArgumentCount() const { return 0; }
+    virtual Result<void> tryValidateArgument(size_t index, Reader &reader) const { return ParseError {ErrorCode::InvalidArgument, reader.getCursor()}; }
+
+    /**
+     * @brief Call the suggestion provider, the arguments being valid
+     */
+    virtual void provideSuggestions(TypeHolder &holder, SuggestionsBuilder &builder) const {}
+
+    /**
+     * @brief Collect every suggestion for the input
+     */
+    virtual std::vector<std::string> listSuggestions(TypeHolder &holder, Reader &reader) const
+    {
+        std::vector<std::string> suggestions;
+        SuggestionsBuilder builder(suggestions);
+        listSuggestions(holder, reader, builder);
+        return suggestions;
+    }
+
+    virtual std::vector<std::string> suggestArguments(TypeHolder &holder, Reader &reader) const
+    {
+        std::vector<std::string> suggestions;
+        SuggestionsBuilder builder(suggestions);
+        suggestArguments(holder, reader, builder);
+        return suggestions;
+    }
     virtual const std::vector<std::string> &getAliases() const = 0;
 
-    // virtual void findAmbiguities(std::shared_ptr<ICommandNode> parent, AmbiguityConsumer &consumer) = 0;
+    /**
+     * @brief Get the counters of this node, nullptr if it keeps none
+     *
+     * Always nullptr unless `options::metrics` is enabled.
+     */
+    virtual _util::Counters *getCounters() const { return nullptr; }
+
+    /**
+     * @brief Whether the first argument of this node accepts the whole token, false if it has no arguments nor callback
+     *
+     * Used to find the children named like a value of the argument, see `Ambiguity::ShadowedArgument`.
+     */
+    virtual bool acceptsArgument(std::string_view token) const { return false; }
+
+    /**
+     * @brief Report the tokens which the dispatcher could read in two ways in the subtree of this node
+     *
+     * @param path The names from the root to this node, separated by spaces
+     * @param consumer
+     */
+    virtual void findAmbiguities(std::string &path, const AmbiguityConsumer &consumer) const;
 };
+
+namespace _util {
+/**
+ * @brief Report the ambiguities between children, and between each child and the arguments of their parent, then recurse
+ *
+ * @param parent
+ * @param children
+ * @param path The path of parent
+ * @param consumer
+ */
+inline void findAmbiguities(const ICommandNode &parent, std::span<const std::shared_ptr<ICommandNode>> children, std::string &path, const AmbiguityConsumer &consumer)
+{
+    std::unordered_map<std::string_view, const ICommandNode *> owners;
+    for (auto &child : children) {
+        auto check = [&](std::string_view key) {
+            auto [owner, added] = owners.try_emplace(key, child.get());
+            if (!added && owner->second != child.get())
+                consumer(Ambiguity {Ambiguity::DuplicateLiteral, path, std::string(key), owner->second, child.get()});
+            else if (added && parent.acceptsArgument(key))
+                consumer(Ambiguity {Ambiguity::ShadowedArgument, path, std::string(key), child.get(), &parent});
+        };
+        check(child->getName());
+        for (auto &alias : child->getAliases())
+            check(alias);
+    }
+    for (auto &child : children) {
+        auto length = path.size();
+        if (!path.empty())
+            path += ' ';
+        path += child->getName();
+        child->findAmbiguities(path, consumer);
+        path.resize(length);
+    }
+}
+} // namespace _util
+
+inline void ICommandNode::findAmbiguities(std::string &path, const AmbiguityConsumer &consumer) const { _util::findAmbiguities(*this, getChildren(), path, consumer); }
 } // namespace brigadier
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <brigadier/options.hpp>
+
+namespace brigadier {
+/**
+ * @brief A latency distribution with power-of-two buckets
+ *
+ * Bucket 0 counts durations under 1ns, bucket i those in [2^(i-1), 2^i) ns and the last one everything above.
+ */
+struct Histogram {
+    static constexpr size_t bucketCount = 32;
+
+    std::array<uint64_t, bucketCount> buckets {};
+
+    static constexpr size_t bucketOf(std::chrono::nanoseconds duration)
+    {
+        auto ns = static_cast<uint64_t>(duration.count() < 0 ? 0 : duration.count());
+        return std::min<size_t>(std::bit_width(ns), bucketCount - 1);
+    }
+
+    /**
+     * @brief Get the upper bound of a bucket, the largest representable duration for the last one
+     */
+    static constexpr std::chrono::nanoseconds upperBound(size_t bucket)
+    {
+        if (bucket + 1 >= bucketCount)
+            return std::chrono::nanoseconds::max();
+        return std::chrono::nanoseconds(int64_t(1) << bucket);
+    }
+
+    uint64_t count() const
+    {
+        uint64_t total = 0;
+        for (auto n : buckets)
+            total += n;
+        return total;
+    }
+
+    /**
+     * @brief Get an upper bound of the quantile q of the durations
+     *
+     * @param q In [0, 1], e.g. 0.99
+     * @return std::chrono::nanoseconds 0 if nothing was recorded
+     */
+    std::chrono::nanoseconds quantile(double q) const
+    {
+        auto total = count();
+        if (total == 0)
+            return std::chrono::nanoseconds(0);
+        auto rank = static_cast<uint64_t>(q * double(total - 1)) + 1;
+        for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            if (buckets[bucket] >= rank)
+                return upperBound(bucket);
+            rank -= buckets[bucket];
+        }
+        return upperBound(bucketCount - 1);
+    }
+};
+
+/**
+ * @brief What happened to a node, summed over every thread
+ */
+struct NodeMetrics {
+    uint64_t dispatches = 0;        ///< Calls to the callback
+    uint64_t failures = 0;          ///< Invalid arguments, or no callback
+    uint64_t permissionDenials = 0; ///< Permission predicates returning false
+    uint64_t suggestions = 0;       ///< Suggestion requests ending on the node
+    Histogram parse;                ///< Time spent parsing the arguments
+    Histogram execute;              ///< Time spent in the callback
+};
+
+/**
+ * @brief The metrics of the nodes of a registry at some point in time
+ *
+ * Only the nodes that recorded something are listed, in depth-first order.
+ */
+struct MetricsSnapshot {
+    struct Entry {
+        std::string path; ///< The names from the root, separated by spaces
+        NodeMetrics metrics;
+    };
+
+    std::vector<Entry> nodes;
+
+    /**
+     * @return const NodeMetrics* nullptr if the node recorded nothing
+     */
+    const NodeMetrics *find(std::string_view path) const
+    {
+        for (auto &entry : nodes) {
+            if (entry.path == path)
+                return &entry.metrics;
+        }
+        return nullptr;
+    }
+};
+
+namespace _util {
+/**
+ * @brief The counters of a node, sharded per thread
+ *
+ * Each thread increments the shard it was assigned with relaxed atomics, so that threads dispatching
+ * the same command do not share cache lines as long as there are fewer threads than shards.
+ * Shards are allocated the first time the node records something: idle nodes cost one pointer.
+ */
+class NodeCounters {
+public:
+    enum Counter : size_t { Failures, PermissionDenials, Suggestions, CounterCount };
+
+    NodeCounters() = default;
+    NodeCounters(const NodeCounters &) = delete;
+    NodeCounters &operator=(const NodeCounters &) = delete;
+
+    ~NodeCounters() { delete[] _shards.load(std::memory_order_acquire); }
+
+    void add(Counter counter) { shard().counters[counter].fetch_add(1, std::memory_order_relaxed); }
+    void recordParse(std::chrono::nanoseconds duration) { shard().parse[Histogram::bucketOf(duration)].fetch_add(1, std::memory_order_relaxed); }
+    void recordExecute(std::chrono::nanoseconds duration) { shard().execute[Histogram::bucketOf(duration)].fetch_add(1, std::memory_order_relaxed); }
+
+    bool empty() const { return _shards.load(std::memory_order_acquire) == nullptr; }
+
+    NodeMetrics collect() const
+    {
+        NodeMetrics metrics;
+        auto shards = _shards.load(std::memory_order_acquire);
+        if (shards == nullptr)
+            return metrics;
+        for (size_t i = 0; i < shardCount; ++i) {
+            auto &shard = shards[i];
+            metrics.failures += shard.counters[Failures].load(std::memory_order_relaxed);
+            metrics.permissionDenials += shard.counters[PermissionDenials].load(std::memory_order_relaxed);
+            metrics.suggestions += shard.counters[Suggestions].load(std::memory_order_relaxed);
+            for (size_t bucket = 0; bucket < Histogram::bucketCount; ++bucket) {
+                metrics.parse.buckets[bucket] += shard.parse[bucket].load(std::memory_order_relaxed);
+                metrics.execute.buckets[bucket] += shard.execute[bucket].load(std::memory_order_relaxed);
+            }
+        }
+        // Every callback call records its duration
+        metrics.dispatches = metrics.execute.count();
+        return metrics;
+    }
+
+    /**
+     * @brief Zero the counters, increments racing with it may be lost
+     */
+    void reset()
+    {
+        auto shards = _shards.load(std::memory_order_acquire);
+        if (shards == nullptr)
+            return;
+        for (size_t i = 0; i < shardCount; ++i) {
+            for (auto &counter : shards[i].counters)
+                counter.store(0, std::memory_order_relaxed);
+            for (size_t bucket = 0; bucket < Histogram::bucketCount; ++bucket) {
+                shards[i].parse[bucket].store(0, std::memory_order_relaxed);
+                shards[i].execute[bucket].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t shardCount = 8;
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> counters[CounterCount] {};
+        std::atomic<uint64_t> parse[Histogram::bucketCount] {};
+        std::atomic<uint64_t> execute[Histogram::bucketCount] {};
+    };
+
+    static size_t threadShard()
+    {
+        static std::atomic<size_t> next {0};
+        thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed) % shardCount;
+        return index;
+    }
+
+    Shard &shard()
+    {
+        auto shards = _shards.load(std::memory_order_acquire);
+        if (shards == nullptr) {
+            auto allocated = new Shard[shardCount];
+            if (_shards.compare_exchange_strong(shards, allocated, std::memory_order_acq_rel))
+                shards = allocated;
+            else
+                delete[] allocated;
+        }
+        return shards[threadShard()];
+    }
+
+private:
+    std::atomic<Shard *> _shards {nullptr};
+};
+
+/**
+ * @brief Stand-in for `NodeCounters` when metrics are compiled out
+ */
+struct NoCounters {
+    void add(size_t) {}
+    void recordParse(std::chrono::nanoseconds) {}
+    void recordExecute(std::chrono::nanoseconds) {}
+    bool empty() const { return true; }
+    NodeMetrics collect() const { return {}; }
+    void reset() {}
+};
+
+using Counters = std::conditional_t<options::metrics, NodeCounters, NoCounters>;
+
+/**
+ * @brief Measures successive intervals, when metrics are enabled
+ *
+ * Reading the clock costs tens of nanoseconds, `lap` reuses the end of an interval as the start of the next.
+ */
+class Stopwatch {
+public:
+    Stopwatch()
+    {
+        if constexpr (options::metrics)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Get the time since the construction or the previous lap, and start a new interval
+     */
+    std::chrono::nanoseconds lap()
+    {
+        if constexpr (options::metrics) {
+            auto now = std::chrono::steady_clock::now();
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(now - std::exchange(_start, now));
+        }
+        return std::chrono::nanoseconds(0);
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+};
+} // namespace _util
+} // namespace brigadier
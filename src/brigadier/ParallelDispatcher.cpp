@@ -0,0 +1,168 @@
+#include <brigadier/ParallelDispatcher.hpp>
+#include <algorithm>
+#include <exception>
+#include <latch>
+#include <optional>
+#include <unordered_map>
+
+brigadier::ParallelDispatcher::ParallelDispatcher(const Registry &registry, size_t workers):
+    _registry(registry)
+{
+    workers = std::max<size_t>(workers, 1);
+    for (size_t i = 0; i < workers; ++i)
+        _workers.emplace_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < workers; ++i)
+        _workers[i]->thread = std::thread(&ParallelDispatcher::run, this, i);
+}
+
+brigadier::ParallelDispatcher::~ParallelDispatcher()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _wakeup.notify_all();
+    for (auto &worker : _workers)
+        worker->thread.join();
+}
+
+bool brigadier::ParallelDispatcher::tryPop(size_t index, std::function<void()> &task)
+{
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        auto &worker = *_workers[(index + i) % _workers.size()];
+        std::lock_guard lock(worker.mutex);
+        if (worker.tasks.empty())
+            continue;
+        if (i == 0) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        } else {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void brigadier::ParallelDispatcher::push(size_t index, std::function<void()> task)
+{
+    auto &worker = *_workers[index % _workers.size()];
+    std::lock_guard lock(worker.mutex);
+    _queued.fetch_add(1, std::memory_order_relaxed);
+    worker.tasks.emplace_back(std::move(task));
+}
+
+void brigadier::ParallelDispatcher::wakeWorkers()
+{
+    {
+        // Workers check _queued under this lock before sleeping
+        std::lock_guard lock(_mutex);
+    }
+    _wakeup.notify_all();
+}
+
+void brigadier::ParallelDispatcher::run(size_t index)
+{
+    std::function<void()> task;
+
+    while (true) {
+        if (tryPop(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock lock(_mutex);
+        _wakeup.wait(lock, [this] {
+            return _stopping || _queued.load(std::memory_order_relaxed) > 0;
+        });
+        if (_stopping && _queued.load(std::memory_order_relaxed) == 0)
+            return;
+    }
+}
+
+std::vector<brigadier::Result<void>> brigadier::ParallelDispatcher::dispatch(std::span<const Command> commands, Execution execution)
+{
+    std::vector<Result<void>> results(commands.size());
+    std::vector<std::optional<ParseResults>> parsed(execution == Execution::Caller ? commands.size() : 0);
+    std::vector<std::vector<uint32_t>> sources;
+    std::unordered_map<const void *, size_t> sourceIndex;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    for (uint32_t i = 0; i < commands.size(); ++i) {
+        auto [it, inserted] = sourceIndex.try_emplace(commands[i].source.get(), sources.size());
+        if (inserted)
+            sources.emplace_back();
+        sources[it->second].push_back(i);
+    }
+    if (sources.empty())
+        return results;
+
+    std::latch done(static_cast<std::ptrdiff_t>(sources.size()));
+    for (size_t s = 0; s < sources.size(); ++s) {
+        push(s, [&, s] {
+            try {
+                for (auto i : sources[s]) {
+                    auto command = _registry.parseOnly(commands[i].source, commands[i].input);
+                    if (execution == Execution::Caller)
+                        parsed[i].emplace(std::move(command));
+                    else if (command)
+                        _registry.execute(command);
+                    else
+                        results[i] = command.getError();
+                }
+            } catch (...) {
+                std::lock_guard lock(exceptionMutex);
+                if (!exception)
+                    exception = std::current_exception();
+            }
+            done.count_down();
+        });
+    }
+    wakeWorkers();
+    done.wait();
+
+    if (exception)
+        std::rethrow_exception(exception);
+    if (execution == Execution::Caller) {
+        for (size_t i = 0; i < commands.size(); ++i) {
+            if (*parsed[i])
+                _registry.execute(*parsed[i]);
+            else
+                results[i] = parsed[i]->getError();
+        }
+    }
+    return results;
+}
+
+void brigadier::ParallelDispatcher::forEach(size_t count, const Function<void(size_t)> &task)
+{
+    struct State {
+        std::atomic<size_t> next = 0;
+        std::atomic<size_t> done = 0;
+        size_t count;
+        const Function<void(size_t)> *task;
+    };
+
+    // Helpers popped after the last index was claimed only touch the state, which they keep alive
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->task = &task;
+    auto drain = [](State &state) {
+        size_t ran = 0;
+        for (size_t i; (i = state.next.fetch_add(1, std::memory_order_relaxed)) < state.count; ++ran)
+            (*state.task)(size_t(i));
+        if (ran != 0 && state.done.fetch_add(ran, std::memory_order_acq_rel) + ran == state.count)
+            state.done.notify_all();
+    };
+
+    auto helpers = std::min(_workers.size(), count > 0 ? count - 1 : 0);
+    for (size_t h = 0; h < helpers; ++h)
+        push(h, [state, drain] { drain(*state); });
+    if (helpers != 0)
+        wakeWorkers();
+    drain(*state);
+    for (auto done = state->done.load(std::memory_order_acquire); done != count; done = state->done.load(std::memory_order_acquire))
+        state->done.wait(done, std::memory_order_acquire);
+}
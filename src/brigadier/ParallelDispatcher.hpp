@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <brigadier/Executor.hpp>
+#include <brigadier/Registry.hpp>
+#include <brigadier/Result.hpp>
+
+namespace brigadier {
+/**
+ * @brief Dispatches batches of commands on a fixed pool of worker threads
+ *
+ * The commands of a batch are split by source, each source being a task, and tasks are spread
+ * over per-worker deques: a worker takes its own tasks from the back and steals the ones of
+ * other workers from the front when it runs out.
+ * The commands of a source are always handled in the order of the batch, commands sent
+ * without source (nullptr) are considered to share the same source.
+ *
+ * Commands are parsed with `Registry::parseOnly`, so the whole input must be a command.
+ *
+ * @code
+ * ParallelDispatcher dispatcher(registry, 4);
+ * auto results = dispatcher.dispatch(commands, ParallelDispatcher::Execution::Caller);
+ * @endcode
+ *
+ * The registry may be modified while a batch is dispatched, each command sees either the previous tree or the new one.
+ *
+ * It is also the `Executor` of fork nodes, which run the sources of a command on its workers.
+ *
+ * @warning The registry must outlive the dispatcher
+ */
+class ParallelDispatcher : public Executor {
+public:
+    /**
+     * @brief Where the callbacks of the commands are executed
+     */
+    enum class Execution {
+        Workers, ///< On the workers, as soon as a command is parsed
+        Caller, ///< On the thread calling `dispatch`, once the whole batch is parsed, in the order of the batch
+    };
+
+    /**
+     * @brief Start the workers
+     *
+     * @param registry
+     * @param workers The number of worker threads, at least one
+     */
+    explicit ParallelDispatcher(const Registry &registry, size_t workers = std::thread::hardware_concurrency());
+
+    ParallelDispatcher(const ParallelDispatcher &) = delete;
+    ParallelDispatcher &operator=(const ParallelDispatcher &) = delete;
+
+    /**
+     * @brief Stop and join the workers
+     */
+    ~ParallelDispatcher() override;
+
+    /**
+     * @brief Parse and execute a batch of commands, blocking until all of them are handled
+     *
+     * If a callback throws, the rest of its source is skipped and the first exception is rethrown once the batch is done.
+     *
+     * @param commands
+     * @param execution
+     * @return std::vector<Result<void>> The result of each command, in the same order
+     */
+    std::vector<Result<void>> dispatch(std::span<const Command> commands, Execution execution = Execution::Workers);
+
+    /**
+     * @brief Call task with each index in [0, count) on the workers and the calling thread
+     *
+     * Indices are claimed one at a time, so a slow one does not hold the others back.
+     * It may be called from a worker, e.g. by a command dispatched on it.
+     *
+     * @param count
+     * @param task Must not throw
+     */
+    void forEach(size_t count, const Function<void(size_t)> &task) override;
+
+    size_t getWorkerCount() const { return _workers.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+    };
+
+    void run(size_t index);
+    void push(size_t index, std::function<void()> task);
+    void wakeWorkers();
+    bool tryPop(size_t index, std::function<void()> &task);
+
+private:
+    const Registry &_registry;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::atomic<size_t> _queued = 0;
+    bool _stopping = false;
+};
+} // namespace brigadier
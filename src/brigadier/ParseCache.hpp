@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <brigadier/ParseResults.hpp>
+#include <brigadier/Result.hpp>
+
+namespace brigadier {
+/**
+ * @brief A bounded least-recently-used cache of parsed commands, keyed by their input
+ *
+ * Each entry owns a copy of its input, the arguments are parsed from that copy. Entries are
+ * shared with the callers, so the views of the arguments into the input stay valid for as long
+ * as a caller holds the entry, even once it is evicted. Invalid inputs are cached too, with
+ * their error, so that repeating one does not parse it again.
+ *
+ * All members are thread-safe.
+ */
+class ParseCache {
+public:
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t size;
+        size_t capacity;
+    };
+
+    /**
+     * @brief An input and what it parsed to
+     */
+    struct Parsed {
+        std::string input; ///< The copy the arguments view into
+        std::unique_ptr<const BoundArguments> arguments; ///< nullptr if no command was bound
+        ParseError error; ///< Relative to the input, `ErrorCode::None` if the whole input is the command
+
+        /**
+         * @brief Whether the input starts with a valid command, maybe followed by more input
+         */
+        bool hasCommand() const { return arguments != nullptr; }
+    };
+
+    /**
+     * @param capacity The maximum number of entries, must not be 0
+     */
+    explicit ParseCache(size_t capacity):
+        _capacity(capacity)
+    {
+    }
+
+    /**
+     * @brief Find what an input parsed to, counting a hit or a miss
+     *
+     * @param input
+     * @return std::shared_ptr<const Parsed> nullptr if the input is not cached
+     */
+    std::shared_ptr<const Parsed> find(std::string_view input)
+    {
+        std::lock_guard lock(_mutex);
+        auto it = _index.find(input);
+        if (it == _index.end()) {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return *it->second;
+    }
+
+    /**
+     * @brief Parse an input and cache the outcome, valid or not
+     *
+     * @param input
+     * @param parse Called with the new entry, whose input is set, to set its arguments and error
+     * @return std::shared_ptr<const Parsed>
+     */
+    template<typename F>
+    std::shared_ptr<const Parsed> insert(std::string_view input, F &&parse)
+    {
+        auto parsed = std::make_shared<Parsed>();
+        parsed->input = input;
+        parse(*parsed);
+
+        std::lock_guard lock(_mutex);
+        auto it = _index.find(input);
+        if (it != _index.end())
+            return *it->second;
+        if (_index.size() >= _capacity) {
+            _index.erase(_entries.back()->input);
+            _entries.pop_back();
+        }
+        _entries.push_front(std::move(parsed));
+        _index.emplace(_entries.front()->input, _entries.begin());
+        return _entries.front();
+    }
+
+    /**
+     * @brief Drop every entry, the counters are kept
+     */
+    void clear()
+    {
+        std::lock_guard lock(_mutex);
+        _index.clear();
+        _entries.clear();
+    }
+
+    size_t getCapacity() const { return _capacity; }
+
+    Stats getStats() const
+    {
+        std::lock_guard lock(_mutex);
+        return {_hits.load(std::memory_order_relaxed), _misses.load(std::memory_order_relaxed), _index.size(), _capacity};
+    }
+
+private:
+    const size_t _capacity;
+    mutable std::mutex _mutex;
+    std::list<std::shared_ptr<const Parsed>> _entries; ///< Most recently used first
+    std::unordered_map<std::string_view, std::list<std::shared_ptr<const Parsed>>::iterator> _index; ///< Keys point into the entries
+    std::atomic<size_t> _hits = 0;
+    std::atomic<size_t> _misses = 0;
+};
+} // namespace brigadier
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <brigadier/Result.hpp>
+#include <brigadier/TypeHolder.hpp>
+
+namespace brigadier {
+class ICommandNode;
+
+/**
+ * @brief The parsed arguments of a command node, bound to its callback
+ */
+class BoundArguments {
+public:
+    virtual ~BoundArguments() = default;
+
+    /**
+     * @brief Call the callback of the node with the parsed arguments
+     *
+     * @param source
+     */
+    virtual void execute(TypeHolder &source) const = 0;
+};
+
+/**
+ * @brief The outcome of parsing a command without executing it
+ *
+ * Holds everything needed to execute the command later without parsing it again:
+ * the nodes the input resolved to, the parsed arguments and the consumed range of the input.
+ * It can be executed any number of times with `Registry::execute`.
+ *
+ * @code
+ * auto results = registry.parseOnly(player, reader);
+ * if (!results)
+ *     return reportError(results.getError());
+ * registry.execute(results);
+ * @endcode
+ *
+ * @warning Arguments parsed as views (e.g. `StringViewParser`) point into the input, which must outlive the results
+ */
+class ParseResults {
+public:
+    ParseResults(TypeHolder source, std::string_view input, size_t start):
+        _source(std::move(source)),
+        _input(input),
+        _start(start),
+        _end(start)
+    {
+    }
+
+    /**
+     * @brief Check whether the input is a complete, valid command
+     *
+     * @return bool
+     */
+    bool isValid() const { return _error.code == ErrorCode::None && _arguments != nullptr; }
+    explicit operator bool() const { return isValid(); }
+
+    /**
+     * @brief Get the error that stopped parsing, `ErrorCode::None` if there is none
+     *
+     * @return const ParseError&
+     */
+    const ParseError &getError() const { return _error; }
+
+    /**
+     * @brief Get the nodes the input resolved to, from the root command to the executed node
+     *
+     * @return const std::vector<const ICommandNode *>&
+     */
+    const std::vector<const ICommandNode *> &getPath() const { return _path; }
+
+    /**
+     * @brief Get the node that will be executed
+     *
+     * @return const ICommandNode* nullptr if no command was resolved
+     */
+    const ICommandNode *getNode() const { return _path.empty() ? nullptr : _path.back(); }
+
+    TypeHolder &getSource() { return _source; }
+    std::string_view getInput() const { return _input; }
+
+    /**
+     * @brief Get the part of the input that was parsed
+     *
+     * @return std::string_view
+     */
+    std::string_view getRange() const { return _input.substr(_start, _end - _start); }
+    size_t getStart() const { return _start; }
+    size_t getEnd() const { return _end; }
+
+    /**
+     * @brief Get the parsed arguments, nullptr if the command is invalid
+     *
+     * @return const BoundArguments*
+     */
+    const BoundArguments *getArguments() const { return _arguments.get(); }
+
+private:
+    friend class Registry;
+
+    TypeHolder _source;
+    std::string_view _input;
+    size_t _start;
+    size_t _end;
+    std::vector<const ICommandNode *> _path;
+    std::shared_ptr<const ICommandNode> _root; ///< Keeps the tree alive if the command is removed from the registry
+    std::unique_ptr<BoundArguments> _arguments;
+    ParseError _error;
+};
+} // namespace brigadier
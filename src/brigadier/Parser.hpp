@@ -1,8 +1,12 @@
 #pragma once
 
+#include <brigadier/Result.hpp>
+#include <brigadier/Tracing.hpp>
+#include <brigadier/exceptions.hpp>
 #include <brigadier/reader/Reader.hpp>
 #include <concepts>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
 namespace brigadier {
@@ -22,23 +26,47 @@ namespace brigadier {
  *   static int parse(Reader &reader) { return reader.readInt(); }
  * };
  * @endcode
+ *
+ * The parse method can also be a template over the reader type, so that command nodes
+ * parsing from a `StringViewReader` get it inlined instead of going through virtual calls:
+ *
+ * @code
+ * struct MyParser : public Parser {
+ *    using type = int;
+ *
+ *   template<is_reader R>
+ *   static int parse(R &reader) { return reader.readInt(); }
+ * };
+ * @endcode
+ *
+ * A parser can also, or instead, provide a non-throwing `tryParse` returning a `Result`,
+ * which is what command nodes use. Parsers only providing `parse` have their exceptions caught:
+ *
+ * @code
+ * struct MyParser : public Parser {
+ *    using type = int;
+ *
+ *   template<is_reader R>
+ *   static Result<int> tryParse(R &reader) { return reader.tryReadInt(); }
+ * };
+ * @endcode
  */
 struct Parser {
     Parser() = delete;
 };
 
 /**
- * @brief Check if type T is a brigadier parser
- *
- * @tparam T The class to check
+ * @brief Check if parser T has a throwing parse method accepting R
  */
-template<typename T>
-concept is_parser = std::is_base_of<Parser, T>::value && std::is_base_of<std::false_type, std::is_same<typename T::type, void>>::value && requires(Reader &reader) {
+template<typename T, typename R = Reader>
+concept has_parse = requires(R &reader) {
     // clang-format off
 
     /**
      * @brief Parse an object of type T from the reader
      *
+     * @throw CommandSyntaxException If the input is invalid
+     *
      * @param reader
      * @return typename T::type
      */
@@ -46,4 +74,191 @@ concept is_parser = std::is_base_of<Parser, T>::value && std::is_base_of<std::fa
     // clang-format on
 };
 
+/**
+ * @brief Check if parser T has a non-throwing tryParse method accepting R
+ */
+template<typename T, typename R = Reader>
+concept has_try_parse = requires(R &reader) {
+    // clang-format off
+
+    /**
+     * @brief Parse an object of type T from the reader without throwing
+     *
+     * @param reader
+     * @return Result<typename T::type>
+     */
+    { T::tryParse(reader) } -> std::same_as<Result<typename T::type>>;
+    // clang-format on
+};
+
+/**
+ * @brief Check if parser T has a tryValidate method accepting R
+ *
+ * Optional: it lets validation skip an argument without building its value, e.g. without allocating a string.
+ */
+template<typename T, typename R = Reader>
+concept has_try_validate = requires(R &reader) {
+    // clang-format off
+
+    /**
+     * @brief Move the reader past a valid argument, without building it
+     *
+     * @param reader
+     * @return Result<void>
+     */
+    { T::tryValidate(reader) } -> std::same_as<Result<void>>;
+    // clang-format on
+};
+
+/**
+ * @brief Check if parser T has a canStartWith predicate
+ *
+ * Optional: it tells which characters the input of the parser can start with,
+ * e.g. to find the literals which are also valid arguments. Parsers without it may start with anything.
+ */
+template<typename T>
+concept has_can_start_with = requires(char c, const CharClasses &classes) {
+    // clang-format off
+
+    /**
+     * @brief Whether a valid argument can start with c
+     *
+     * @param c
+     * @param classes The character classes of the reader
+     * @return bool
+     */
+    { T::canStartWith(c, classes) } -> std::same_as<bool>;
+    // clang-format on
+};
+
+/**
+ * @brief Check if type T is a brigadier parser
+ *
+ * @tparam T The class to check
+ * @tparam R The reader the parser must accept, `Reader` accepts every reader
+ */
+template<typename T, typename R = Reader>
+concept is_parser = std::is_base_of<Parser, T>::value && std::is_base_of<std::false_type, std::is_same<typename T::type, void>>::value && is_reader<R> &&
+    (has_parse<T, R> || has_try_parse<T, R>);
+
+namespace _util {
+/**
+ * @brief Whether an argument of parser P can start with c, true if P does not tell
+ */
+template<typename P>
+constexpr bool canStartWith(char c, const CharClasses &classes)
+{
+    if constexpr (has_can_start_with<P>)
+        return P::canStartWith(c, classes);
+    else
+        return true;
+}
+
+/**
+ * @brief Parse an argument without throwing, whatever the parser provides
+ */
+template<typename P, is_reader R>
+    requires is_parser<P, R>
+Result<typename P::type> tryParseArgument(R &reader)
+{
+    auto start = reader.getCursor();
+    TraceSpan span("parser", start, [] { return typeName<P>(); });
+    if constexpr (has_try_parse<P, R>) {
+        auto result = P::tryParse(reader);
+        span.close(result, reader);
+        return result;
+    } else {
+        ParseError error {ErrorCode::InvalidArgument, start};
+        try {
+            Result<typename P::type> result = P::parse(reader);
+            span.close(result, reader);
+            return result;
+        } catch (const CommandSyntaxException &e) {
+            error.code = e.getError().code;
+        } catch (const ReaderException &) {
+        } catch (const ParserException &) {
+        }
+        reader.setCursor(start);
+        span.close(start, error.code);
+        return error;
+    }
+}
+
+/**
+ * @brief Parse an argument, whatever the parser provides
+ *
+ * @throw CommandSyntaxException If the input is invalid
+ */
+template<typename P, is_reader R>
+    requires is_parser<P, R>
+typename P::type parseArgument(R &reader)
+{
+    if constexpr (has_parse<P, R>)
+        return P::parse(reader);
+    else
+        return valueOrThrow(P::tryParse(reader), reader);
+}
+
+/**
+ * @brief Parse the arguments of each parser, from left to right, stopping at the first error
+ *
+ * On error the cursor is moved back to where the first argument started.
+ */
+template<typename... Parsers, is_reader R>
+    requires(is_parser<Parsers, R> && ...)
+Result<std::tuple<typename Parsers::type...>> tryParseArguments(R &reader)
+{
+    if constexpr (sizeof...(Parsers) == 0) {
+        return std::tuple<> {};
+    } else {
+        return [&]<typename First, typename... Rest>(std::tuple<First, Rest...> *) -> Result<std::tuple<typename Parsers::type...>> {
+            auto start = reader.getCursor();
+            auto first = tryParseArgument<First>(reader);
+            if (!first)
+                return first.error();
+            auto rest = tryParseArguments<Rest...>(reader);
+            if (!rest) {
+                reader.setCursor(start);
+                return rest.error();
+            }
+            return std::tuple_cat(std::tuple<typename First::type>(std::move(*first)), std::move(*rest));
+        }(static_cast<std::tuple<Parsers...> *>(nullptr));
+    }
+}
+
+/**
+ * @brief Move the reader past an argument without keeping its value, whatever the parser provides
+ */
+template<typename P, is_reader R>
+    requires is_parser<P, R>
+Result<void> tryValidateArgument(R &reader)
+{
+    if constexpr (has_try_validate<P, R>) {
+        return P::tryValidate(reader);
+    } else {
+        auto argument = tryParseArgument<P>(reader);
+        if (!argument)
+            return argument.error();
+        return {};
+    }
+}
+
+/**
+ * @brief Move the reader past the arguments of each parser, stopping at the first error
+ *
+ * On error the cursor is moved back to where the first argument started.
+ */
+template<typename... Parsers, is_reader R>
+    requires(is_parser<Parsers, R> && ...)
+Result<void> tryValidateArguments(R &reader)
+{
+    auto start = reader.getCursor();
+    Result<void> result;
+    if (((result = tryValidateArgument<Parsers>(reader)) && ...))
+        return result;
+    reader.setCursor(start);
+    return result;
+}
+} // namespace _util
+
 } // namespace brigadier
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace brigadier::_util {
+/**
+ * @brief A value published with read-copy-update
+ *
+ * Readers get the current version with `read()`, which never blocks nor takes a lock: it only increments a counter.
+ * Writers copy the current version, modify the copy and publish it with an atomic swap of the pointer.
+ * Writers are serialized between themselves, and never wait for readers.
+ *
+ * The previous versions are retired with the epoch they were replaced in. The epoch only advances once no
+ * reader is left in the epoch before it, so a version is deleted two epochs later, by whichever of the
+ * writers or the last reader of its epoch gets there first: nothing waits for the readers, and a value that
+ * stops changing does not keep its previous versions.
+ *
+ * @tparam T Must be copy-constructible
+ */
+template<typename T>
+class Rcu {
+public:
+    /**
+     * @brief Keeps a version alive, for as long as it exists
+     */
+    class ReadGuard {
+    public:
+        ReadGuard(const Rcu &owner, const T *value, std::atomic<size_t> &readers):
+            _owner(&owner),
+            _value(value),
+            _readers(&readers)
+        {
+        }
+
+        ReadGuard(ReadGuard &&other) noexcept:
+            _owner(other._owner),
+            _value(std::exchange(other._value, nullptr)),
+            _readers(std::exchange(other._readers, nullptr))
+        {
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+        ReadGuard &operator=(ReadGuard &&) = delete;
+
+        ~ReadGuard()
+        {
+            if (_readers == nullptr)
+                return;
+            _readers->fetch_sub(1);
+            if (_owner->_retired.load() != nullptr)
+                _owner->reclaim();
+        }
+
+        const T *operator->() const { return _value; }
+        const T &operator*() const { return *_value; }
+
+    private:
+        const Rcu *_owner;
+        const T *_value;
+        std::atomic<size_t> *_readers;
+    };
+
+    Rcu():
+        _current(new T())
+    {
+    }
+
+    Rcu(const Rcu &) = delete;
+    Rcu(Rcu &&) = delete;
+    Rcu &operator=(const Rcu &) = delete;
+    Rcu &operator=(Rcu &&) = delete;
+
+    ~Rcu()
+    {
+        delete _current.load();
+        for (auto retired = _retired.load(); retired != nullptr;) {
+            delete retired->value;
+            delete std::exchange(retired, retired->next);
+        }
+    }
+
+    /**
+     * @brief Enter a read section and get the current version
+     *
+     * @return ReadGuard
+     */
+    ReadGuard read() const
+    {
+        while (true) {
+            auto epoch = _epoch.load();
+            auto &readers = _readers[epoch & 1];
+            readers.fetch_add(1);
+            // Counted in the epoch only if it did not advance meanwhile, otherwise the version could be deleted under it
+            if (_epoch.load() == epoch)
+                return ReadGuard(*this, _current.load(), readers);
+            readers.fetch_sub(1);
+        }
+    }
+
+    /**
+     * @brief Get the current version without entering a read section
+     *
+     * @warning Only valid until the next update
+     */
+    const T &unsafeGet() const { return *_current.load(); }
+
+    /**
+     * @brief Publish a modified copy of the current version
+     *
+     * @param update Called with the copy, under the lock of the writers: it must not update this value
+     */
+    template<typename F>
+    void update(F &&update)
+    {
+        {
+            std::lock_guard lock(_writer);
+            auto next = new T(*_current.load());
+            try {
+                update(*next);
+            } catch (...) {
+                delete next;
+                throw;
+            }
+            auto previous = _current.exchange(next);
+            push(new Retired {previous, _epoch.load(), nullptr});
+        }
+        reclaim();
+    }
+
+private:
+    struct Retired {
+        T *value;
+        size_t epoch; ///< When value was replaced, the readers that can see it entered in this epoch or the one before
+        Retired *next;
+    };
+
+    /**
+     * @brief Add a list of retired versions to the retired ones
+     */
+    void push(Retired *list) const
+    {
+        auto last = list;
+        while (last->next != nullptr)
+            last = last->next;
+        auto head = _retired.load();
+        do
+            last->next = head;
+        while (!_retired.compare_exchange_weak(head, list));
+    }
+
+    /**
+     * @brief Advance the epoch, if no reader is left in the epoch before the current one
+     *
+     * @return bool Whether the epoch advanced, by this thread or another one
+     */
+    bool tryAdvance() const
+    {
+        auto epoch = _epoch.load();
+        if (_readers[(epoch + 1) & 1].load() != 0)
+            return false;
+        _epoch.compare_exchange_strong(epoch, epoch + 1);
+        return true;
+    }
+
+    /**
+     * @brief Delete the retired versions no reader can see any more, without waiting for the others
+     *
+     * The versions still visible are kept for the last reader of their epoch, which calls it again when it leaves.
+     */
+    void reclaim() const
+    {
+        while (auto retired = _retired.exchange(nullptr)) {
+            tryAdvance();
+            tryAdvance();
+            auto epoch = _epoch.load();
+            Retired *kept = nullptr;
+            while (retired != nullptr) {
+                auto next = retired->next;
+                if (retired->epoch + 2 <= epoch) {
+                    delete retired->value;
+                    delete retired;
+                } else {
+                    retired->next = kept;
+                    kept = retired;
+                }
+                retired = next;
+            }
+            if (kept == nullptr)
+                return;
+            push(kept);
+            // A reader that left before the push did not see the kept versions, retry if one could have
+            if (!tryAdvance())
+                return;
+        }
+    }
+
+private:
+    std::atomic<T *> _current;
+    mutable std::atomic<size_t> _epoch = 0;
+    mutable std::atomic<size_t> _readers[2] = {0, 0}; ///< The readers of the even and odd epochs
+    std::mutex _writer;
+    mutable std::atomic<Retired *> _retired = nullptr;
+};
+} // namespace brigadier::_util
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <brigadier/Executor.hpp>
+#include <brigadier/Function.hpp>
+#include <brigadier/ICommandNode.hpp>
+#include <brigadier/ParseResults.hpp>
+#include <brigadier/TypeHolder.hpp>
+
+namespace brigadier::_util {
+/**
+ * @brief Where a redirect or fork node sends the rest of the input, see `CommandNodeBuilder::redirect`
+ *
+ * @tparam Types The types of the arguments of the node, given to the fork
+ */
+template<typename... Types>
+struct Redirect {
+    const ICommandNode *target;
+    std::vector<std::string> path; ///< Literals followed from target, e.g. to reach a command through its registry
+    Function<std::vector<TypeHolder>(TypeHolder &, Types...)> fork; ///< Empty for a redirect, the source is passed through
+    Executor *executor = nullptr;
+    size_t parallelThreshold = 0; ///< The number of sources from which they are handed to the executor
+
+    /**
+     * @brief Follow the path from the target
+     *
+     * @param owner Set to the first node found, if none is set yet, so a reload of the registry does not free it
+     * @return const ICommandNode* nullptr if a literal of the path is missing
+     */
+    const ICommandNode *resolve(std::shared_ptr<const ICommandNode> &owner) const
+    {
+        auto node = target;
+        for (auto &name : path) {
+            node = node->findChild(name);
+            if (node == nullptr)
+                return nullptr;
+            if (owner == nullptr)
+                owner = node->weak_from_this().lock();
+        }
+        return node;
+    }
+};
+
+/**
+ * @brief Split the path of a redirect on whitespace
+ */
+inline std::vector<std::string> splitPath(std::string_view path)
+{
+    std::vector<std::string> names;
+    StringViewReader reader(path);
+    reader.skipWhitespace();
+    while (reader.canRead()) {
+        auto name = reader.tryReadStringView();
+        if (!name)
+            break;
+        names.emplace_back(*name);
+    }
+    return names;
+}
+
+/**
+ * @brief Follow the literals of the input down from node, then bind the arguments of the node reached
+ *
+ * @param node
+ * @param reader
+ * @param owner Set to the first node found, if none is set yet
+ * @return Result<std::unique_ptr<BoundArguments>>
+ */
+template<is_reader R>
+Result<std::unique_ptr<BoundArguments>> bindFrom(const ICommandNode &node, R &reader, std::shared_ptr<const ICommandNode> &owner)
+{
+    auto current = &node;
+    while (reader.canRead()) {
+        auto start = reader.getCursor();
+        auto entry = reader.tryReadStringView();
+        auto child = entry ? current->findChild(*entry) : nullptr;
+        if (child == nullptr) {
+            reader.setCursor(start);
+            break;
+        }
+        if (owner == nullptr)
+            owner = child->weak_from_this().lock();
+        current = child;
+    }
+    return current->tryBind(reader);
+}
+
+/**
+ * @brief Execute the continuation of a fork once per source
+ *
+ * Below the threshold, or without executor, the sources run in order and the first exception stops them.
+ * Otherwise they all run on the executor, and the exception of the first source that threw, in the order
+ * of the sources, is rethrown once they are done.
+ *
+ * @param sources
+ * @param continuation
+ * @param executor
+ * @param threshold
+ */
+inline void forEachSource(std::vector<TypeHolder> &sources, const BoundArguments &continuation, Executor *executor, size_t threshold)
+{
+    if (executor == nullptr || sources.size() < threshold || sources.size() < 2) {
+        for (auto &source : sources)
+            continuation.execute(source);
+        return;
+    }
+    std::vector<std::exception_ptr> exceptions(sources.size());
+    executor->forEach(sources.size(), [&](size_t i) {
+        try {
+            continuation.execute(sources[i]);
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    });
+    for (auto &exception : exceptions) {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
+} // namespace brigadier::_util
@@ -1,75 +1,406 @@
 #include "brigadier/exceptions.hpp"
 #include <brigadier/Registry.hpp>
+#include <algorithm>
+#include <functional>
 
-brigadier::Registry &brigadier::Registry::add(const std::shared_ptr<brigadier::ICommandNode> &node)
+brigadier::Registry::Tree::Tree(const Tree &other):
+    nodes(other.nodes),
+    index(other.index),
+    cache(other.cache ? std::make_unique<ParseCache>(other.cache->getCapacity()) : nullptr),
+    version(other.version + 1)
 {
-    _nodes.emplace_back(node);
+}
+
+brigadier::Registry &brigadier::Registry::add(const std::shared_ptr<brigadier::ICommandNode> &node) { return addAll(std::span(&node, 1)); }
+
+brigadier::Registry &brigadier::Registry::addAll(std::span<const std::shared_ptr<ICommandNode>> nodes)
+{
+    std::vector<Ambiguity> duplicates;
+    _tree.update([&](Tree &tree) {
+        for (auto &node : nodes) {
+            if (_onAmbiguity) {
+                auto check = [&](std::string_view key) {
+                    auto owner = tree.index.find(key);
+                    if (owner != nullptr && owner != node.get())
+                        duplicates.push_back({Ambiguity::DuplicateLiteral, "", std::string(key), owner, node.get()});
+                };
+                check(node->getName());
+                for (auto &alias : node->getAliases())
+                    check(alias);
+            }
+            tree.index.add(node);
+            tree.nodes.emplace_back(node);
+        }
+        tree.index.sortKeys();
+    });
+    if (_onAmbiguity) {
+        for (auto &duplicate : duplicates)
+            _onAmbiguity(duplicate);
+        for (auto &node : nodes) {
+            std::string path(node->getName());
+            node->findAmbiguities(path, _onAmbiguity);
+        }
+    }
     return *this;
 }
 
-void brigadier::Registry::parse(const std::string &command) const
+bool brigadier::Registry::remove(std::string_view name)
 {
-    StringReader reader(command);
-    parse(reader);
+    bool removed = false;
+    _tree.update([&](Tree &tree) {
+        removed = std::erase_if(tree.nodes, [&](const auto &node) { return node->getName() == name; }) > 0;
+        tree.index = {};
+        tree.index.addAll(tree.nodes);
+    });
+    return removed;
 }
 
-void brigadier::Registry::parse(Reader &reader) const
+brigadier::Registry &brigadier::Registry::reload(std::vector<std::shared_ptr<ICommandNode>> nodes)
 {
-    TypeHolder holder;
-    parse(holder, reader);
+    _tree.update([&](Tree &tree) {
+        tree.nodes = std::move(nodes);
+        tree.index = {};
+        tree.index.addAll(tree.nodes);
+    });
+    if (_onAmbiguity) {
+        std::string path;
+        findAmbiguities(path, _onAmbiguity);
+    }
+    return *this;
 }
 
-void brigadier::Registry::parse(TypeHolder holder, const std::string &command)
+std::vector<std::shared_ptr<brigadier::ICommandNode>> brigadier::Registry::getSnapshot() const { return _tree.read()->nodes; }
+
+void brigadier::Registry::setCacheCapacity(size_t capacity)
 {
-    StringReader reader(command);
-    parse(holder, reader);
+    _tree.update([&](Tree &tree) { tree.cache = capacity == 0 ? nullptr : std::make_unique<ParseCache>(capacity); });
+}
+
+brigadier::ParseCache::Stats brigadier::Registry::getCacheStats() const
+{
+    auto tree = _tree.read();
+    return tree->cache ? tree->cache->getStats() : ParseCache::Stats {0, 0, 0, 0};
+}
+
+/**
+ * Call f with each node of the subtree and its path
+ */
+template<typename F>
+static void forEachNode(const brigadier::ICommandNode &node, std::string &path, F &&f)
+{
+    auto length = path.size();
+    if (!path.empty())
+        path += ' ';
+    path += node.getName();
+    f(node, path);
+    for (auto &child : node.getChildren())
+        forEachNode(*child, path, f);
+    path.resize(length);
+}
+
+brigadier::MetricsSnapshot brigadier::Registry::getMetrics() const
+{
+    MetricsSnapshot snapshot;
+    if constexpr (options::metrics) {
+        auto tree = _tree.read();
+        std::string path;
+        for (auto &root : tree->nodes) {
+            forEachNode(*root, path, [&](const ICommandNode &node, const std::string &path) {
+                auto counters = node.getCounters();
+                if (counters != nullptr && !counters->empty())
+                    snapshot.nodes.push_back({path, counters->collect()});
+            });
+        }
+    }
+    return snapshot;
+}
+
+void brigadier::Registry::resetMetrics() const
+{
+    if constexpr (options::metrics) {
+        auto tree = _tree.read();
+        std::string path;
+        for (auto &root : tree->nodes) {
+            forEachNode(*root, path, [](const ICommandNode &node, const std::string &) {
+                if (auto counters = node.getCounters())
+                    counters->reset();
+            });
+        }
+    }
+}
+
+std::vector<brigadier::Ambiguity> brigadier::Registry::findAmbiguities() const
+{
+    std::vector<Ambiguity> ambiguities;
+    std::string path;
+    findAmbiguities(path, [&ambiguities](const Ambiguity &ambiguity) { ambiguities.push_back(ambiguity); });
+    return ambiguities;
+}
+
+void brigadier::Registry::findAmbiguities(std::string &path, const AmbiguityConsumer &consumer) const
+{
+    auto tree = _tree.read();
+    _util::findAmbiguities(*this, tree->nodes, path, consumer);
+}
+
+brigadier::Registry &brigadier::Registry::onAmbiguity(AmbiguityConsumer consumer)
+{
+    _onAmbiguity = std::move(consumer);
+    return *this;
+}
+
+brigadier::CompiledRegistry brigadier::Registry::freeze() const { return CompiledRegistry(getSnapshot()); }
+
+/**
+ * Follow the literals of the input down from node, stopping at the first token which is not a child
+ */
+template<brigadier::is_reader R>
+const brigadier::ICommandNode *brigadier::Registry::descend(const ICommandNode *node, R &reader, std::vector<const ICommandNode *> *path) const
+{
+    while (reader.canRead()) {
+        auto nodeStart = reader.getCursor();
+        auto entry = reader.tryReadStringView();
+        auto child = entry ? node->findChild(*entry) : nullptr;
+        if (child == nullptr) {
+            reader.setCursor(nodeStart);
+            break;
+        }
+        node = child;
+        if (path)
+            path->push_back(node);
+    }
+    return node;
+}
+
+template<brigadier::is_reader R>
+brigadier::ParseResults brigadier::Registry::parseOnlyImpl(const Tree &tree, TypeHolder &&source, R &reader, bool keepTrailing) const
+{
+    auto start = reader.getCursor();
+    ParseResults results(std::move(source), reader.getStringView(), start);
+    reader.skipWhitespace();
+    auto cmdStart = reader.getCursor();
+    auto cmd = reader.tryReadStringView();
+    const ICommandNode *node = cmd ? tree.index.find(*cmd) : nullptr;
+    if (node == nullptr) {
+        reader.setCursor(start);
+        results._error = {ErrorCode::UnknownCommand, cmdStart};
+        return results;
+    }
+    results._root = node->weak_from_this().lock();
+    results._path.push_back(node);
+    node = descend(node, reader, &results._path);
+    auto arguments = node->tryBind(reader);
+    if (arguments) {
+        reader.skipWhitespace();
+        if (reader.canRead())
+            results._error = {ErrorCode::ExpectedEndOfCommand, reader.getCursor()};
+        if (!reader.canRead() || keepTrailing)
+            results._arguments = std::move(*arguments);
+    } else {
+        results._error = arguments.error();
+    }
+    results._end = reader.getCursor();
+    reader.setCursor(start);
+    return results;
 }
 
-void brigadier::Registry::parse(TypeHolder &source, Reader &reader) const
+brigadier::ParseResults brigadier::Registry::parseOnly(TypeHolder source, std::string_view command) const
 {
+    StringViewReader reader(command);
+    return parseOnlyImpl(*_tree.read(), std::move(source), reader);
+}
+
+brigadier::ParseResults brigadier::Registry::parseOnly(TypeHolder source, Reader &reader) const { return parseOnlyImpl(*_tree.read(), std::move(source), reader); }
+
+brigadier::ParseResults brigadier::Registry::parseOnly(TypeHolder source, StringViewReader &reader) const { return parseOnlyImpl(*_tree.read(), std::move(source), reader); }
+
+void brigadier::Registry::execute(ParseResults &results) const
+{
+    if (!results)
+        throw CommandSyntaxException(results._error, results._input);
+    results._arguments->execute(results._source);
+}
+
+template<brigadier::is_reader R>
+brigadier::Result<void> brigadier::Registry::tryParseImpl(const Tree &tree, TypeHolder &source, R &reader) const
+{
+    auto start = reader.getCursor();
+    _util::TraceSpan span("registry", start, [&] { return reader.getRemainingView(); });
+    if (tree.cache) {
+        auto input = reader.getRemainingView();
+        auto parsed = tree.cache->find(input);
+        if (!parsed) {
+            parsed = tree.cache->insert(input, [&](ParseCache::Parsed &entry) {
+                StringViewReader keyReader(entry.input);
+                auto results = parseOnlyImpl(tree, TypeHolder(), keyReader, true);
+                entry.arguments = std::move(results._arguments);
+                entry.error = results._error;
+            });
+        }
+        // Trailing input is an error for parseOnly but not for parse, the command before it is executed
+        if (parsed->hasCommand()) {
+            auto trailing = parsed->error.code == ErrorCode::ExpectedEndOfCommand;
+            reader.setCursor(trailing ? start + parsed->error.cursor : reader.getTotalLength());
+            parsed->arguments->execute(source);
+            span.close(Result<void>(), reader);
+            return {};
+        }
+        span.close(start, parsed->error.code);
+        return ParseError {parsed->error.code, start + parsed->error.cursor};
+    }
     reader.skipWhitespace();
-    auto cmd = reader.readString();
-    for (auto &node : _nodes) {
-        if (node->getName() == cmd || std::find(node->getAliases().begin(), node->getAliases().end(), cmd) != node->getAliases().end()) {
-            node->parse(source, reader);
-            return;
+    auto cmdStart = reader.getCursor();
+    auto cmd = reader.tryReadStringView();
+    if (auto node = cmd ? tree.index.find(*cmd) : nullptr) {
+        auto result = node->tryParse(source, reader);
+        if (!result)
+            reader.setCursor(start);
+        span.close(result, reader);
+        return result;
+    }
+    reader.setCursor(start);
+    span.close(start, ErrorCode::UnknownCommand);
+    return ParseError {ErrorCode::UnknownCommand, cmdStart};
+}
+
+brigadier::Result<void> brigadier::Registry::tryParse(std::string_view command) const { return tryParse(TypeHolder(), command); }
+
+brigadier::Result<void> brigadier::Registry::tryParse(TypeHolder holder, std::string_view command) const
+{
+    auto arena = Arena::local();
+    Tokens tokens;
+    StringViewReader reader(command);
+    reader.setMemoryResource(arena.get());
+    reader.setTokens(&tokens);
+    return tryParse(holder, reader);
+}
+
+brigadier::Result<void> brigadier::Registry::tryParse(TypeHolder &source, Reader &reader) const { return tryParseImpl(*_tree.read(), source, reader); }
+
+brigadier::Result<void> brigadier::Registry::tryParse(TypeHolder &source, StringViewReader &reader) const { return tryParseImpl(*_tree.read(), source, reader); }
+
+std::vector<brigadier::Result<void>> brigadier::Registry::parseBatch(std::span<const Command> commands) const
+{
+    struct Resolved {
+        const ICommandNode *node;
+        size_t cursor;
+    };
+
+    auto tree = _tree.read();
+    std::vector<Result<void>> results(commands.size());
+    std::vector<Resolved> resolved(commands.size());
+    std::vector<std::pair<const ICommandNode *, uint32_t>> subtrees;
+
+    // Resolve the root literals, leaves are fully resolved at this point
+    for (uint32_t i = 0; i < commands.size(); ++i) {
+        StringViewReader reader(commands[i].input);
+        reader.skipWhitespace();
+        auto cmdStart = reader.getCursor();
+        auto cmd = reader.tryReadStringView();
+        auto node = cmd ? tree->index.find(*cmd) : nullptr;
+        if (node == nullptr) {
+            results[i] = ParseError {ErrorCode::UnknownCommand, cmdStart};
+            continue;
         }
+        resolved[i] = {node, reader.getCursor()};
+        if (!node->getChildren().empty())
+            subtrees.emplace_back(node, i);
+    }
+
+    // Walk the subtrees one root at a time
+    std::sort(subtrees.begin(), subtrees.end(), [](const auto &lhs, const auto &rhs) {
+        return std::less<>()(lhs.first, rhs.first) || (lhs.first == rhs.first && lhs.second < rhs.second);
+    });
+    for (auto [root, i] : subtrees) {
+        StringViewReader reader(commands[i].input);
+        reader.setCursor(resolved[i].cursor);
+        resolved[i].node = descend(root, reader, nullptr);
+        resolved[i].cursor = reader.getCursor();
     }
-    throw CommandSyntaxException("Unknown command", reader);
+
+    // Execute in the order of the batch
+    for (uint32_t i = 0; i < commands.size(); ++i) {
+        if (resolved[i].node == nullptr)
+            continue;
+        StringViewReader reader(commands[i].input);
+        reader.setCursor(resolved[i].cursor);
+        TypeHolder source(commands[i].source);
+        results[i] = resolved[i].node->tryExecute(source, reader);
+    }
+    return results;
 }
 
-bool brigadier::Registry::isValidInput(const std::string &input) const
+void brigadier::Registry::parse(std::string_view command) const { parse(TypeHolder(), command); }
+
+void brigadier::Registry::parse(Reader &reader) const
 {
-    StringReader reader(input);
-    return isValidInput(reader);
+    TypeHolder holder;
+    parse(holder, reader);
 }
 
-bool brigadier::Registry::isValidInput(Reader &input) const
+void brigadier::Registry::parse(TypeHolder holder, std::string_view command) const
 {
+    auto arena = Arena::local();
+    Tokens tokens;
+    StringViewReader reader(command);
+    reader.setMemoryResource(arena.get());
+    reader.setTokens(&tokens);
+    parse(holder, reader);
+}
+
+void brigadier::Registry::parse(TypeHolder &source, Reader &reader) const { valueOrThrow(tryParseImpl(*_tree.read(), source, reader), reader); }
+
+void brigadier::Registry::parse(TypeHolder &source, StringViewReader &reader) const { valueOrThrow(tryParseImpl(*_tree.read(), source, reader), reader); }
+
+template<brigadier::is_reader R>
+brigadier::Result<void> brigadier::Registry::tryValidateImpl(R &input) const
+{
+    auto tree = _tree.read();
     auto start = input.getCursor();
-    try {
-        for (auto &node : _nodes) {
-            auto entry = input.readString();
-            if (node->getName() == entry || std::find(node->getAliases().begin(), node->getAliases().end(), entry) != node->getAliases().end()) {
-                auto result = node->isValidInput(input);
-                input.setCursor(start);
-                return result;
-            }
-        }
-    } catch (const CommandSyntaxException &e) {
-    } catch (const ParserException &e) {
-    } catch (const ReaderException &e) {
+    input.skipWhitespace();
+    auto cmdStart = input.getCursor();
+    auto entry = input.tryReadStringView();
+    if (auto node = entry ? tree->index.find(*entry) : nullptr) {
+        auto result = node->tryValidate(input);
+        input.setCursor(start);
+        return result;
     }
     input.setCursor(start);
-    return false;
+    return ParseError {ErrorCode::UnknownCommand, cmdStart};
 }
 
-std::vector<std::string> brigadier::Registry::listSuggestions(TypeHolder &holder, Reader &reader) const
+brigadier::Result<void> brigadier::Registry::tryValidate(std::string_view input) const
 {
-    std::string name = reader.readString();
-    for (auto &node : _nodes) {
-        if (node->getName() == name || std::find(node->getAliases().begin(), node->getAliases().end(), name) != node->getAliases().end())
-            return node->listSuggestions(holder, reader);
-    }
-    return {};
+    auto arena = Arena::local();
+    Tokens tokens;
+    StringViewReader reader(input);
+    reader.setMemoryResource(arena.get());
+    reader.setTokens(&tokens);
+    return tryValidate(reader);
+}
+
+brigadier::Result<void> brigadier::Registry::tryValidate(Reader &input) const { return tryValidateImpl(input); }
+
+brigadier::Result<void> brigadier::Registry::tryValidate(StringViewReader &input) const { return tryValidateImpl(input); }
+
+bool brigadier::Registry::isValidInput(std::string_view input) const { return tryValidate(input).hasValue(); }
+
+bool brigadier::Registry::isValidInput(Reader &input) const { return tryValidateImpl(input).hasValue(); }
+
+bool brigadier::Registry::isValidInput(StringViewReader &input) const { return tryValidateImpl(input).hasValue(); }
+
+void brigadier::Registry::listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const
+{
+    auto tree = _tree.read();
+    auto start = reader.getCursor();
+    auto name = reader.tryReadStringView();
+    if (auto node = name ? tree->index.find(*name) : nullptr)
+        return node->listSuggestions(holder, reader, builder);
+    reader.setCursor(start);
+    _util::suggestLiterals(tree->index, holder, reader, builder);
+}
+
+void brigadier::Registry::suggestChildren(const TypeHolder &holder, const Reader &reader, SuggestionsBuilder &builder) const
+{
+    _util::suggestLiterals(_tree.read()->index, holder, reader, builder);
 }
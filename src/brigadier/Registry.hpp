@@ -1,37 +1,256 @@
 #pragma once
 
 #include "brigadier/reader/StringReader.hpp"
+#include "brigadier/reader/StringViewReader.hpp"
+#include <brigadier/Arena.hpp>
+#include <brigadier/ChildIndex.hpp>
 #include <brigadier/CommandNode.hpp>
+#include <brigadier/CompiledRegistry.hpp>
+#include <brigadier/Metrics.hpp>
+#include <brigadier/ParseCache.hpp>
+#include <brigadier/Rcu.hpp>
 #include <brigadier/exceptions.hpp>
+#include <span>
 #include <vector>
 
 namespace brigadier {
+/**
+ * @brief A command to dispatch with `Registry::parseBatch`
+ */
+struct Command {
+    TypeHolder source;
+    std::string_view input;
+};
+
 /**
  * @brief A registry of command nodes
+ *
+ * Thread safety: every `const` member (parsing, validation, suggestions, `parseOnly`/`execute`, `parseBatch`, `freeze`)
+ * may be called concurrently from any number of threads, provided the callbacks, permission predicates
+ * and suggestion providers of the nodes are themselves thread-safe.
+ *
+ * The tree may also be modified while commands are dispatched: it is versioned with read-copy-update.
+ * A dispatch works on the version that was current when it started.
+ * `add`, `addAll`, `remove`, `reload` and `setCacheCapacity` copy the tree and publish the copy atomically: register
+ * many commands with one `addAll` or `reload` rather than one `add` each. Writers are serialized between themselves
+ * but never wait for dispatches, which never wait for writers, so commands may modify any registry from their callbacks.
+ * A previous version is freed once the last dispatch using it returns.
  */
 class Registry : public ICommandNode {
 public:
+    Registry() = default;
+
     /**
-     * @brief Construct a new Registry object
+     * @brief Neither copyable nor movable, redirects and forks may hold its address
+     */
+    Registry(Registry &&) = delete;
+
+    /**
+     * @brief Add a root command
      *
      * @param node
      * @return Registry&
      */
     Registry &add(const std::shared_ptr<ICommandNode> &node);
 
-    void parse(const std::string &command) const;
+    /**
+     * @brief Add root commands, copying the tree once for all of them
+     *
+     * @param nodes
+     * @return Registry&
+     */
+    Registry &addAll(std::span<const std::shared_ptr<ICommandNode>> nodes);
+
+    /**
+     * @brief Remove the root commands named name
+     *
+     * Commands parsed by `parseOnly` keep their nodes alive and can still be executed.
+     *
+     * @param name
+     * @return bool Whether a command was removed
+     */
+    bool remove(std::string_view name);
+
+    /**
+     * @brief Replace every root command at once
+     *
+     * Dispatches see either the previous tree or the new one, never a mix of both.
+     *
+     * @param nodes
+     * @return Registry&
+     */
+    Registry &reload(std::vector<std::shared_ptr<ICommandNode>> nodes);
+
+    /**
+     * @brief Get a copy of the current root commands
+     *
+     * Unlike `getChildren`, it stays valid whatever the writers do.
+     *
+     * @return std::vector<std::shared_ptr<ICommandNode>>
+     */
+    std::vector<std::shared_ptr<ICommandNode>> getSnapshot() const;
+
+    /**
+     * @brief Parse a command and execute it, without throwing on invalid input
+     *
+     * The values of pmr parsers (e.g. `PmrStringParser`) are allocated from a thread-local `Arena`, reset on return.
+     * The input is split into `Tokens` once, nodes moving back to an earlier token do not scan it again.
+     */
+    Result<void> tryParse(std::string_view command) const;
+    Result<void> tryParse(TypeHolder holder, std::string_view command) const;
+
+    template<_util::_isnt_th T, is_reader R>
+    Result<void> tryParse(T &source, R &reader) const
+    {
+        TypeHolder holder(source);
+        return tryParse(holder, reader);
+    }
+
+    template<typename T, is_reader R>
+    Result<void> tryParse(T *source, R &reader) const
+    {
+        TypeHolder holder(source);
+        return tryParse(holder, reader);
+    }
+
+    /**
+     * @brief Parse a command and execute it, without throwing on invalid input
+     *
+     * @param source
+     * @param reader
+     * @return Result<void> The error code and the position where parsing failed, if any
+     */
+    Result<void> tryParse(TypeHolder &source, Reader &reader) const override;
+
+    /**
+     * @see Registry::tryParse
+     */
+    Result<void> tryParse(TypeHolder &source, StringViewReader &reader) const override;
+
+    ParseResults parseOnly(TypeHolder source, std::string_view command) const;
+
+    template<_util::_isnt_th T, is_reader R>
+    ParseResults parseOnly(T &source, R &reader) const
+    {
+        return parseOnly(TypeHolder(source), reader);
+    }
+
+    /**
+     * @brief Parse a command without executing it
+     *
+     * The whole input must be a valid command, the cursor of the reader is left untouched.
+     *
+     * @param source
+     * @param reader
+     * @return ParseResults To be executed with `Registry::execute`
+     */
+    ParseResults parseOnly(TypeHolder source, Reader &reader) const;
+
+    /**
+     * @see Registry::parseOnly
+     */
+    ParseResults parseOnly(TypeHolder source, StringViewReader &reader) const;
+
+    /**
+     * @brief Execute a command parsed by `parseOnly`, without parsing it again
+     *
+     * @throw CommandSyntaxException If the results hold an error
+     *
+     * @param results
+     */
+    void execute(ParseResults &results) const;
+
+    /**
+     * @brief Parse and execute many commands in one call
+     *
+     * Commands are first resolved grouped by root literal, so that each subtree is walked while it is warm,
+     * then their arguments are parsed and their callbacks executed in the order of the batch.
+     * The parse cache is not used.
+     *
+     * @param commands
+     * @return std::vector<Result<void>> The result of each command, in the same order
+     */
+    std::vector<Result<void>> parseBatch(std::span<const Command> commands) const;
+
+    /**
+     * @brief Cache the parsed arguments of the most recently used valid commands
+     *
+     * On a hit, `parse` and `tryParse` execute the cached arguments without tokenizing nor parsing the input.
+     * The cache belongs to a version of the tree: it starts empty, counters included, whenever the tree is modified.
+     *
+     * @param capacity The maximum number of cached commands, 0 disables the cache
+     */
+    void setCacheCapacity(size_t capacity);
+
+    /**
+     * @brief Get the hit and miss counters of the cache
+     *
+     * @return ParseCache::Stats All zero if the cache is disabled
+     */
+    ParseCache::Stats getCacheStats() const;
+
+    /**
+     * @brief Collect the counters and latency histograms of every node of the current tree
+     *
+     * Nodes record their dispatches, failures, permission denials and suggestion requests as they happen,
+     * on every registry sharing them. Requires `options::metrics` (CMake `ENABLE_METRICS`), empty otherwise.
+     *
+     * @return MetricsSnapshot
+     */
+    MetricsSnapshot getMetrics() const;
+
+    /**
+     * @brief Zero the metrics of every node of the current tree
+     */
+    void resetMetrics() const;
+
+    /**
+     * @brief Find the tokens which the current tree could read in two ways
+     *
+     * @see Ambiguity
+     * @return std::vector<Ambiguity>
+     */
+    std::vector<Ambiguity> findAmbiguities() const;
+    void findAmbiguities(std::string &path, const AmbiguityConsumer &consumer) const override;
+
+    /**
+     * @brief Report the ambiguities of the commands as they are registered
+     *
+     * `add` reports those of the added command, `reload` those of the whole tree.
+     *
+     * @warning Not thread-safe, set it before registering commands
+     *
+     * @param consumer nullptr to stop reporting
+     * @return Registry&
+     */
+    Registry &onAmbiguity(AmbiguityConsumer consumer);
+
+    /**
+     * @brief Compile the current tree into an immutable dispatch table
+     *
+     * @return CompiledRegistry
+     */
+    CompiledRegistry freeze() const;
+
+    /**
+     * @brief Parse a command and execute it
+     *
+     * The values of pmr parsers (e.g. `PmrStringParser`) are allocated from a thread-local `Arena`, reset on return.
+     * The input is split into `Tokens` once, nodes moving back to an earlier token do not scan it again.
+     */
+    void parse(std::string_view command) const;
     void parse(Reader &reader) const;
-    void parse(TypeHolder holder, const std::string &command);
+    void parse(TypeHolder holder, std::string_view command) const;
 
-    template<typename T>
-    void parse(T &source, Reader &reader) const
+    template<_util::_isnt_th T, is_reader R>
+    void parse(T &source, R &reader) const
     {
         TypeHolder holder(source);
         parse(holder, reader);
     }
 
-    template<typename T>
-    void parse(T *source, Reader &reader) const
+    template<typename T, is_reader R>
+    void parse(T *source, R &reader) const
     {
         TypeHolder holder(source);
         parse(holder, reader);
@@ -45,18 +264,93 @@ public:
      */
     void parse(TypeHolder &source, Reader &reader) const override;
 
-    constexpr const std::vector<std::shared_ptr<ICommandNode>> &getChildren() const override { return _nodes; }
+    /**
+     * @see Registry::parse
+     */
+    void parse(TypeHolder &source, StringViewReader &reader) const override;
+
+    /**
+     * @warning Only valid until the tree is modified, use `getSnapshot` when writers may run concurrently
+     */
+    const std::vector<std::shared_ptr<ICommandNode>> &getChildren() const override { return _tree.unsafeGet().nodes; }
+
+    /**
+     * @warning Only valid until the node is removed
+     */
+    const ICommandNode *findChild(std::string_view name) const override { return _tree.read()->index.find(name); }
     constexpr std::string_view getName() const override { return "<root>"; }
     constexpr std::string_view getUsage() const override { return ""; }
-    constexpr bool canUse(const TypeHolder &source) override { return true; }
+    constexpr bool canUse(const TypeHolder &source) const override { return true; }
     [[noreturn]] const std::vector<std::string> &getAliases() const override { throw std::runtime_error("Not implemented"); }
 
-    bool isValidInput(const std::string &input) const;
+    /**
+     * @brief Check that the input is a valid command without executing it
+     *
+     * The cursor of the reader is left untouched.
+     *
+     * @param input
+     * @return Result<void> The error code and the position where validation failed, if any
+     */
+    Result<void> tryValidate(std::string_view input) const;
+    Result<void> tryValidate(Reader &input) const override;
+    Result<void> tryValidate(StringViewReader &input) const override;
+
+    Result<void> tryExecute(TypeHolder &source, Reader &reader) const override { return ParseError {ErrorCode::InvalidCommand, reader.getCursor()}; }
+    Result<std::unique_ptr<BoundArguments>> tryBind(Reader &reader) const override { return ParseError {ErrorCode::InvalidCommand, reader.getCursor()}; }
+    Result<void> tryValidateArguments(Reader &input) const override { return ParseError {ErrorCode::InvalidCommand, input.getCursor()}; }
+    void suggestArguments(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const override {}
+
+    bool isValidInput(std::string_view input) const;
     bool isValidInput(Reader &input) const override;
-    [[nodiscard]] std::vector<std::string> listSuggestions(TypeHolder &holder, Reader &reader) const override;
+    bool isValidInput(StringViewReader &input) const override;
+
+    using ICommandNode::listSuggestions;
+    using ICommandNode::suggestArguments;
+
+    /**
+     * @brief Stream the suggestions for the input into a builder
+     *
+     * @param holder
+     * @param reader
+     * @param builder Its limit and prefix apply to the whole request
+     */
+    void listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const override;
+    void suggestChildren(const TypeHolder &holder, const Reader &reader, SuggestionsBuilder &builder) const override;
+
+private:
+    friend class SuggestionSession;
+
+    /**
+     * @brief A version of the tree, immutable once published
+     */
+    struct Tree {
+        std::vector<std::shared_ptr<ICommandNode>> nodes;
+        _util::ChildIndex index;
+        std::unique_ptr<ParseCache> cache;
+        uint64_t version = 0; ///< Incremented by every update
+
+        Tree() = default;
+        Tree(const Tree &other);
+    };
+
+    template<is_reader R>
+    Result<void> tryParseImpl(const Tree &tree, TypeHolder &source, R &reader) const;
+
+    template<is_reader R>
+    Result<void> tryValidateImpl(R &input) const;
+
+    /**
+     * @param keepTrailing Keep the arguments when the command is followed by more input, as `parse` accepts it
+     */
+    template<is_reader R>
+    ParseResults parseOnlyImpl(const Tree &tree, TypeHolder &&source, R &reader, bool keepTrailing = false) const;
+
+    template<is_reader R>
+    const ICommandNode *descend(const ICommandNode *node, R &reader, std::vector<const ICommandNode *> *path) const;
 
 private:
-    std::vector<std::shared_ptr<ICommandNode>> _nodes;
+    _util::Rcu<Tree> _tree;
+    AmbiguityConsumer _onAmbiguity;
 };
 
 } // namespace brigadier
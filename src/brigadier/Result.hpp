@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace brigadier {
+/**
+ * @brief Why an input could not be read, parsed or dispatched
+ */
+enum class ErrorCode : uint8_t {
+    None = 0,
+
+    //* Reader
+    ExpectedString,
+    ExpectedQuote,
+    ExpectedEndOfQuote,
+    ExpectedEscapeSequence,
+    InvalidBool,
+    ExpectedInt,
+    ExpectedLong,
+    ExpectedFloat,
+    ExpectedDouble,
+    ExpectedNumber,
+    NumberOutOfRange,
+
+    //* Parser
+    InvalidArgument,
+
+    //* Dispatch
+    UnknownCommand,
+    InvalidCommand,
+    ExpectedEndOfCommand,
+};
+
+/**
+ * @brief Get a short human-readable description of an error code
+ *
+ * @param code
+ * @return std::string_view
+ */
+constexpr std::string_view getErrorMessage(ErrorCode code)
+{
+    switch (code) {
+    case ErrorCode::None:
+        return "No error";
+    case ErrorCode::ExpectedString:
+        return "Expected string";
+    case ErrorCode::ExpectedQuote:
+        return "Expected quote";
+    case ErrorCode::ExpectedEndOfQuote:
+        return "Expected closing quote";
+    case ErrorCode::ExpectedEscapeSequence:
+        return "Expected escape sequence";
+    case ErrorCode::InvalidBool:
+        return "Invalid bool";
+    case ErrorCode::ExpectedInt:
+        return "Expected int";
+    case ErrorCode::ExpectedLong:
+        return "Expected long";
+    case ErrorCode::ExpectedFloat:
+        return "Expected float";
+    case ErrorCode::ExpectedDouble:
+        return "Expected double";
+    case ErrorCode::ExpectedNumber:
+        return "Expected number";
+    case ErrorCode::NumberOutOfRange:
+        return "Number out of range";
+    case ErrorCode::InvalidArgument:
+        return "Invalid argument";
+    case ErrorCode::UnknownCommand:
+        return "Unknown command";
+    case ErrorCode::InvalidCommand:
+        return "Invalid command";
+    case ErrorCode::ExpectedEndOfCommand:
+        return "Expected end of command";
+    }
+    return "Unknown error";
+}
+
+/**
+ * @brief An error and the position of the reader where it happened
+ */
+struct ParseError {
+    ErrorCode code = ErrorCode::None;
+    size_t cursor = 0;
+
+    constexpr bool operator==(const ParseError &) const = default;
+};
+
+/**
+ * @brief Either a value or a `ParseError`, in the spirit of `std::expected`
+ *
+ * This is what the non-throwing API (`Reader::tryRead*`, `Parser::tryParse`, `Registry::tryParse`...) returns,
+ * the throwing API is a thin wrapper on top of it.
+ *
+ * @tparam T The type of the value
+ */
+template<typename T>
+class Result {
+public:
+    constexpr Result(T value):
+        _storage(std::in_place_index<0>, std::move(value))
+    {
+    }
+
+    constexpr Result(ParseError error):
+        _storage(std::in_place_index<1>, error)
+    {
+    }
+
+    constexpr bool hasValue() const { return _storage.index() == 0; }
+    constexpr explicit operator bool() const { return hasValue(); }
+
+    constexpr T &value() & { return std::get<0>(_storage); }
+    constexpr const T &value() const & { return std::get<0>(_storage); }
+    constexpr T &&value() && { return std::get<0>(std::move(_storage)); }
+
+    constexpr T &operator*() & { return value(); }
+    constexpr const T &operator*() const & { return value(); }
+    constexpr T &&operator*() && { return std::move(*this).value(); }
+    constexpr T *operator->() { return &value(); }
+    constexpr const T *operator->() const { return &value(); }
+
+    /**
+     * @brief Get the error, only valid if there is no value
+     *
+     * @return const ParseError&
+     */
+    constexpr const ParseError &error() const { return std::get<1>(_storage); }
+
+private:
+    std::variant<T, ParseError> _storage;
+};
+
+/**
+ * @brief A result without value, success is represented by `ErrorCode::None`
+ */
+template<>
+class Result<void> {
+public:
+    constexpr Result() = default;
+
+    constexpr Result(ParseError error):
+        _error(error)
+    {
+    }
+
+    constexpr bool hasValue() const { return _error.code == ErrorCode::None; }
+    constexpr explicit operator bool() const { return hasValue(); }
+
+    constexpr const ParseError &error() const { return _error; }
+
+private:
+    ParseError _error;
+};
+
+} // namespace brigadier
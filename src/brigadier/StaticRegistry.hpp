@@ -0,0 +1,667 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <brigadier/Arena.hpp>
+#include <brigadier/ChildIndex.hpp>
+#include <brigadier/ICommandNode.hpp>
+#include <brigadier/Parser.hpp>
+#include <brigadier/Result.hpp>
+#include <brigadier/SuggestionsBuilder.hpp>
+#include <brigadier/Tracing.hpp>
+#include <brigadier/TypeHolder.hpp>
+#include <brigadier/exceptions.hpp>
+#include <brigadier/reader/Reader.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
+
+namespace brigadier {
+namespace _util {
+/**
+ * @brief A string literal usable as a template argument
+ */
+template<size_t N>
+struct FixedString {
+    char value[N] {};
+
+    constexpr FixedString(const char (&string)[N]) { std::copy_n(string, N, value); }
+
+    constexpr std::string_view view() const { return {value, N - 1}; }
+};
+} // namespace _util
+
+/**
+ * @brief An alias of the enclosing `Literal`
+ */
+template<_util::FixedString Name>
+struct Alias {};
+
+/**
+ * @brief The arguments of the enclosing `Literal`, parsed in order after its name
+ */
+template<typename... Parsers>
+    requires(is_parser<Parsers> && ...)
+struct Args {};
+
+/**
+ * @brief The callback of the enclosing `Literal`
+ *
+ * @tparam Callback A function pointer or a captureless lambda, called with the source and the parsed arguments
+ */
+template<auto Callback>
+struct Executes {};
+
+/**
+ * @brief A node of a `StaticRegistry`
+ *
+ * @tparam Name
+ * @tparam Parts In any order: `Alias`es, at most one `Args`, at most one `Executes` and the child `Literal`s
+ */
+template<_util::FixedString Name, typename... Parts>
+struct Literal {};
+
+namespace _util {
+enum class StaticPartKind { Other, Literal, Alias, Args, Executes };
+
+template<typename T>
+inline constexpr StaticPartKind staticPartKind = StaticPartKind::Other;
+
+template<FixedString Name, typename... Parts>
+inline constexpr StaticPartKind staticPartKind<Literal<Name, Parts...>> = StaticPartKind::Literal;
+
+template<FixedString Name>
+inline constexpr StaticPartKind staticPartKind<Alias<Name>> = StaticPartKind::Alias;
+
+template<typename... Parsers>
+inline constexpr StaticPartKind staticPartKind<Args<Parsers...>> = StaticPartKind::Args;
+
+template<auto Callback>
+inline constexpr StaticPartKind staticPartKind<Executes<Callback>> = StaticPartKind::Executes;
+
+template<typename T>
+inline constexpr std::string_view aliasName {};
+
+template<FixedString Name>
+inline constexpr std::string_view aliasName<Alias<Name>> = Name.view();
+
+/**
+ * @brief The parts of the given kind, as a tuple
+ */
+template<StaticPartKind Kind, typename... Parts>
+using StaticPartsOf = decltype(std::tuple_cat(std::declval<std::conditional_t<staticPartKind<Parts> == Kind, std::tuple<Parts>, std::tuple<>>>()...));
+
+/**
+ * @brief The 64-bit FNV-1a hash of a key
+ */
+constexpr uint64_t hashKey(std::string_view key)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (auto c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief A perfect hash of a fixed set of keys, built at compile time
+ *
+ * Hash and displace: the keys are split into buckets by their hash, then for each bucket, fullest first,
+ * a seed is searched so that the keys of the bucket land in free slots once rehashed with it.
+ * A lookup hashes the key once, mixes the hash with the seed of its bucket and compares a single key.
+ *
+ * @tparam N The number of keys
+ */
+template<size_t N>
+class PerfectHash {
+    static_assert(N < 0xFFFF, "Too many keys");
+
+public:
+    static constexpr size_t bucketCount = std::bit_ceil(std::max<size_t>(N, 1));
+    static constexpr size_t slotCount = bucketCount * 2;
+
+    /**
+     * @brief Build the table, fails to compile if two keys are equal
+     *
+     * @param keys
+     */
+    constexpr explicit PerfectHash(const std::array<std::string_view, N> &keys):
+        _keys(keys)
+    {
+        // The keys ordered by bucket
+        std::array<uint64_t, N> hashes {};
+        std::array<size_t, bucketCount + 1> firsts {};
+        std::array<uint16_t, N> members {};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = hashKey(keys[i]);
+            ++firsts[bucketOf(hashes[i]) + 1];
+        }
+        size_t largest = 0;
+        for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            largest = std::max(largest, firsts[bucket + 1]);
+            firsts[bucket + 1] += firsts[bucket];
+        }
+        auto next = firsts;
+        for (size_t i = 0; i < N; ++i)
+            members[next[bucketOf(hashes[i])]++] = static_cast<uint16_t>(i);
+
+        for (auto size = largest; size > 0; --size) {
+            for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+                if (firsts[bucket + 1] - firsts[bucket] == size)
+                    place(bucket, std::span(members).subspan(firsts[bucket], size), hashes);
+            }
+        }
+    }
+
+    /**
+     * @brief Find the index of a key
+     *
+     * @param key
+     * @return size_t N if it is not one of the keys
+     */
+    constexpr size_t find(std::string_view key) const
+    {
+        auto hash = hashKey(key);
+        auto entry = _slots[slotOf(hash, _seeds[bucketOf(hash)])];
+        return entry != 0 && _keys[entry - 1] == key ? entry - 1 : N;
+    }
+
+private:
+    /**
+     * The high bits of FNV-1a barely depend on the last characters of short keys, they are mixed first
+     */
+    static constexpr uint64_t mix(uint64_t hash)
+    {
+        hash ^= hash >> 30;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 27;
+        hash *= 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+        return hash;
+    }
+
+    static constexpr size_t bucketOf(uint64_t hash) { return (mix(hash) >> 32) & (bucketCount - 1); }
+
+    static constexpr size_t slotOf(uint64_t hash, uint32_t seed) { return mix(hash + seed * 0x9E3779B97F4A7C15ull) & (slotCount - 1); }
+
+    constexpr void place(size_t bucket, std::span<const uint16_t> members, const std::array<uint64_t, N> &hashes)
+    {
+        // Equal keys share their bucket, and no seed would separate them
+        for (size_t i = 0; i < members.size(); ++i) {
+            for (size_t j = i + 1; j < members.size(); ++j) {
+                if (_keys[members[i]] == _keys[members[j]])
+                    throw std::logic_error("Two nodes of the same parent share a name or alias");
+            }
+        }
+        for (uint32_t seed = 0; seed < 0x10000; ++seed) {
+            size_t placed = 0;
+            for (; placed < members.size(); ++placed) {
+                auto &slot = _slots[slotOf(hashes[members[placed]], seed)];
+                if (slot != 0)
+                    break;
+                slot = static_cast<uint16_t>(members[placed] + 1);
+            }
+            if (placed == members.size()) {
+                _seeds[bucket] = seed;
+                return;
+            }
+            while (placed-- > 0)
+                _slots[slotOf(hashes[members[placed]], seed)] = 0;
+        }
+        throw std::logic_error("No seed places the bucket");
+    }
+
+private:
+    std::array<std::string_view, N> _keys;
+    std::array<uint32_t, bucketCount> _seeds {};
+    std::array<uint16_t, slotCount> _slots {}; ///< Index in _keys plus one, 0 for an empty slot
+};
+
+template<typename Node>
+struct StaticNode;
+
+/**
+ * @brief The children of a static node, or the roots of a `StaticRegistry`
+ */
+template<typename... Nodes>
+struct StaticLevel {
+    static constexpr size_t keyCount = ((1 + StaticNode<Nodes>::aliases.size()) + ... + 0);
+
+    /**
+     * @brief The names and aliases of the nodes
+     */
+    static constexpr std::array<std::string_view, keyCount> keys = [] {
+        std::array<std::string_view, keyCount> keys {};
+        size_t i = 0;
+        auto add = [&](std::string_view name, const auto &aliases) {
+            keys[i++] = name;
+            for (auto alias : aliases)
+                keys[i++] = alias;
+        };
+        (add(StaticNode<Nodes>::name, StaticNode<Nodes>::aliases), ...);
+        (void)add; // Unused by leaves
+        return keys;
+    }();
+
+    /**
+     * @brief The node of each key, by position in Nodes
+     */
+    static constexpr std::array<uint16_t, keyCount> targets = [] {
+        std::array<uint16_t, keyCount> targets {};
+        size_t i = 0;
+        uint16_t node = 0;
+        auto add = [&](size_t count) {
+            for (size_t k = 0; k < count; ++k)
+                targets[i++] = node;
+            ++node;
+        };
+        (add(1 + StaticNode<Nodes>::aliases.size()), ...);
+        return targets;
+    }();
+
+    static constexpr PerfectHash<keyCount> table {keys};
+
+    /**
+     * @brief Indices in keys by key, case-sensitively or not, for completion
+     */
+    static constexpr std::array<uint16_t, keyCount> sortKeys(bool ignoreCase)
+    {
+        std::array<uint16_t, keyCount> order {};
+        for (size_t i = 0; i < keyCount; ++i)
+            order[i] = static_cast<uint16_t>(i);
+        std::sort(order.begin(), order.end(), [ignoreCase](uint16_t lhs, uint16_t rhs) {
+            return ChildIndex::less(keys[lhs], keys[rhs], ignoreCase);
+        });
+        return order;
+    }
+
+    static constexpr std::array<uint16_t, keyCount> sorted = sortKeys(false);
+    static constexpr std::array<uint16_t, keyCount> folded = sortKeys(true);
+
+    /**
+     * @brief Call f with the node named or aliased key
+     *
+     * @param key
+     * @param f Called with `std::type_identity<Node>`
+     * @return bool Whether there is such a node
+     */
+    template<typename F>
+    static bool visit(std::string_view key, F &&f)
+    {
+        auto found = table.find(key);
+        if (found == keyCount)
+            return false;
+        size_t node = 0;
+        // Cast, the fold is a lone false for leaves
+        (void)((node++ == targets[found] && (f(std::type_identity<Nodes> {}), true)) || ...);
+        return true;
+    }
+
+    /**
+     * @brief Suggest the keys completing the token being typed
+     *
+     * @see suggestLiterals
+     */
+    static void suggest(const Reader &reader, SuggestionsBuilder &builder)
+    {
+        auto partial = reader.getRemainingView();
+        if (!std::ranges::all_of(partial, [&reader](char c) { return reader.isAllowedInUnquotedString(c); }))
+            return;
+        auto ignoreCase = builder.isCaseInsensitive();
+        auto &order = ignoreCase ? folded : sorted;
+        auto it = std::lower_bound(order.begin(), order.end(), partial, [&](uint16_t key, std::string_view prefix) {
+            return ChildIndex::less(keys[key], prefix, ignoreCase);
+        });
+        for (; it != order.end() && ChildIndex::startsWith(keys[*it], partial, ignoreCase); ++it) {
+            if (!builder.suggest(keys[*it]))
+                return;
+        }
+    }
+};
+
+template<typename Tuple>
+struct StaticLevelOf;
+
+template<typename... Nodes>
+struct StaticLevelOf<std::tuple<Nodes...>> {
+    using type = StaticLevel<Nodes...>;
+};
+
+/**
+ * @brief The dispatch code of a `Literal`, it behaves as the `CommandNode` it describes
+ */
+template<FixedString Name, typename... Parts>
+struct StaticNode<Literal<Name, Parts...>> {
+    static_assert(((staticPartKind<Parts> != StaticPartKind::Other) && ...), "The parts of a Literal are Alias, Args, Executes and Literal");
+    static_assert(std::tuple_size_v<StaticPartsOf<StaticPartKind::Args, Parts...>> <= 1, "A Literal has at most one Args");
+    static_assert(std::tuple_size_v<StaticPartsOf<StaticPartKind::Executes, Parts...>> <= 1, "A Literal has at most one Executes");
+
+    using Arguments = std::tuple_element_t<0, decltype(std::tuple_cat(StaticPartsOf<StaticPartKind::Args, Parts...>(), std::tuple<Args<>>()))>;
+    using Callback = StaticPartsOf<StaticPartKind::Executes, Parts...>;
+    using Children = typename StaticLevelOf<StaticPartsOf<StaticPartKind::Literal, Parts...>>::type;
+
+    static constexpr std::string_view name = Name.view();
+
+    static constexpr auto aliases = [] {
+        std::array<std::string_view, ((staticPartKind<Parts> == StaticPartKind::Alias) + ... + 0)> aliases {};
+        size_t i = 0;
+        ((staticPartKind<Parts> == StaticPartKind::Alias ? void(aliases[i++] = aliasName<Parts>) : void()), ...);
+        return aliases;
+    }();
+
+    /**
+     * @see CommandNode::tryParse
+     */
+    template<is_reader R>
+    static Result<void> tryParse(TypeHolder &source, R &reader)
+    {
+        auto start = reader.getCursor();
+        _util::TraceSpan span("node", start, [] { return name; });
+        // Leaves do not even read the next token
+        if (Children::keyCount != 0 && reader.canRead()) {
+            Result<void> result;
+            auto entry = reader.tryReadStringView();
+            if (entry && Children::visit(*entry, [&]<typename Child>(std::type_identity<Child>) { result = StaticNode<Child>::tryParse(source, reader); })) {
+                if (!result)
+                    reader.setCursor(start);
+                span.close(result, reader);
+                return result;
+            }
+            reader.setCursor(start);
+        }
+        auto result = tryExecute(source, reader);
+        span.close(result, reader);
+        return result;
+    }
+
+    /**
+     * @see CommandNode::tryExecute
+     */
+    template<is_reader R>
+    static Result<void> tryExecute(TypeHolder &source, R &reader)
+    {
+        if constexpr (std::tuple_size_v<Callback> == 0)
+            return ParseError {ErrorCode::InvalidCommand, reader.getCursor()};
+        else
+            return execute(source, reader, static_cast<Arguments *>(nullptr), static_cast<std::tuple_element_t<0, Callback> *>(nullptr));
+    }
+
+    /**
+     * @see CommandNode::tryValidate
+     */
+    template<is_reader R>
+    static Result<void> tryValidate(R &reader)
+    {
+        auto start = reader.getCursor();
+        if (Children::keyCount != 0 && reader.canRead()) {
+            Result<void> result;
+            auto entry = reader.tryReadStringView();
+            if (entry && Children::visit(*entry, [&]<typename Child>(std::type_identity<Child>) { result = StaticNode<Child>::tryValidate(reader); })) {
+                reader.setCursor(start);
+                return result;
+            }
+            reader.setCursor(start);
+        }
+        return tryValidateArguments(reader, static_cast<Arguments *>(nullptr));
+    }
+
+    /**
+     * @see CommandNode::listSuggestions
+     */
+    static void listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder)
+    {
+        auto start = reader.getCursor();
+        auto entry = reader.tryReadStringView();
+        if (entry && Children::visit(*entry, [&]<typename Child>(std::type_identity<Child>) { StaticNode<Child>::listSuggestions(holder, reader, builder); }))
+            return;
+        reader.setCursor(start);
+        Children::suggest(reader, builder);
+    }
+
+private:
+    template<is_reader R, typename... Parsers, auto F>
+    static Result<void> execute(TypeHolder &source, R &reader, Args<Parsers...> *, Executes<F> *)
+    {
+        static_assert(std::is_invocable_v<decltype(F), TypeHolder &, typename Parsers::type...>, "The callback must take the source and the arguments of the Literal");
+        auto arguments = _util::tryParseArguments<Parsers...>(reader);
+        if (!arguments)
+            return arguments.error();
+        std::apply(
+            [&](auto &...args) {
+                std::invoke(F, source, std::move(args)...);
+            },
+            *arguments
+        );
+        return {};
+    }
+
+    template<is_reader R, typename... Parsers>
+    static Result<void> tryValidateArguments(R &reader, Args<Parsers...> *)
+    {
+        auto start = reader.getCursor();
+        if constexpr (std::tuple_size_v<Callback> == 0) {
+            return ParseError {ErrorCode::InvalidCommand, start};
+        } else {
+            auto arguments = _util::tryValidateArguments<Parsers...>(reader);
+            if (!arguments)
+                return arguments;
+            reader.skipWhitespace();
+            auto end = reader.getCursor();
+            reader.setCursor(start);
+            if (end != reader.getTotalLength())
+                return ParseError {ErrorCode::ExpectedEndOfCommand, end};
+            return {};
+        }
+    }
+};
+} // namespace _util
+
+/**
+ * @brief A command tree described by its type, dispatched by code generated at compile time
+ *
+ * For a command set fixed at compile time: there are no nodes at runtime. Each level of the tree looks
+ * its literals up in a perfect hash table built by the compiler, then calls straight into the code of
+ * the node it found, where the parsers and the callback are inlined. Sharing a name or alias between
+ * siblings fails to compile.
+ *
+ * It parses, validates and completes commands exactly as a `Registry` holding the equivalent `CommandNode`s,
+ * and is an `ICommandNode` like it. Permission predicates, suggestion providers, metrics and the parse cache
+ * are not supported.
+ *
+ * @code
+ * void give(TypeHolder &source, std::string_view item, int count);
+ *
+ * StaticRegistry<
+ *     Literal<"give", Alias<"g">, Args<StringViewParser, NumberParser<int>>, Executes<&give>>,
+ *     Literal<"time", Literal<"set", Args<NumberParser<int>>, Executes<[](TypeHolder &, int time) { ... }>>>
+ * > registry;
+ * registry.parse(player, "give diamond 64");
+ * @endcode
+ *
+ * @tparam Roots The root `Literal`s
+ */
+template<typename... Roots>
+    requires((_util::staticPartKind<Roots> == _util::StaticPartKind::Literal) && ...)
+class StaticRegistry : public ICommandNode {
+    using Level = _util::StaticLevel<Roots...>;
+
+public:
+    /**
+     * @brief Parse a command and execute it, without throwing on invalid input
+     *
+     * @see Registry::tryParse
+     */
+    Result<void> tryParse(std::string_view command) const { return tryParse(TypeHolder(), command); }
+
+    Result<void> tryParse(TypeHolder holder, std::string_view command) const
+    {
+        auto arena = Arena::local();
+        Tokens tokens;
+        StringViewReader reader(command);
+        reader.setMemoryResource(arena.get());
+        reader.setTokens(&tokens);
+        return tryParse<StringViewReader>(holder, reader);
+    }
+
+    template<_util::_isnt_th T, is_reader R>
+    Result<void> tryParse(T &source, R &reader) const
+    {
+        TypeHolder holder(source);
+        return tryParse<R>(holder, reader);
+    }
+
+    Result<void> tryParse(TypeHolder &source, Reader &reader) const override { return tryParse<Reader>(source, reader); }
+    Result<void> tryParse(TypeHolder &source, StringViewReader &reader) const override { return tryParse<StringViewReader>(source, reader); }
+
+    /**
+     * @see Registry::tryParse
+     */
+    template<is_reader R>
+    Result<void> tryParse(TypeHolder &source, R &reader) const
+    {
+        auto start = reader.getCursor();
+        _util::TraceSpan span("registry", start, [&] { return reader.getRemainingView(); });
+        reader.skipWhitespace();
+        auto cmdStart = reader.getCursor();
+        Result<void> result = ParseError {ErrorCode::UnknownCommand, cmdStart};
+        auto cmd = reader.tryReadStringView();
+        if (cmd && Level::visit(*cmd, [&]<typename Node>(std::type_identity<Node>) { result = _util::StaticNode<Node>::tryParse(source, reader); })) {
+            if (!result)
+                reader.setCursor(start);
+            span.close(result, reader);
+            return result;
+        }
+        reader.setCursor(start);
+        span.close(start, ErrorCode::UnknownCommand);
+        return result;
+    }
+
+    /**
+     * @brief Parse a command and execute it
+     *
+     * @throw CommandSyntaxException If the command is invalid
+     */
+    void parse(std::string_view command) const { parse(TypeHolder(), command); }
+
+    void parse(TypeHolder holder, std::string_view command) const
+    {
+        auto arena = Arena::local();
+        Tokens tokens;
+        StringViewReader reader(command);
+        reader.setMemoryResource(arena.get());
+        reader.setTokens(&tokens);
+        parse<StringViewReader>(holder, reader);
+    }
+
+    template<_util::_isnt_th T, is_reader R>
+    void parse(T &source, R &reader) const
+    {
+        TypeHolder holder(source);
+        parse<R>(holder, reader);
+    }
+
+    void parse(TypeHolder &source, Reader &reader) const override { parse<Reader>(source, reader); }
+    void parse(TypeHolder &source, StringViewReader &reader) const override { parse<StringViewReader>(source, reader); }
+
+    template<is_reader R>
+    void parse(TypeHolder &source, R &reader) const
+    {
+        valueOrThrow(tryParse<R>(source, reader), reader);
+    }
+
+    /**
+     * @brief Check that the input is a valid command without executing it
+     *
+     * @see Registry::tryValidate
+     */
+    Result<void> tryValidate(std::string_view input) const
+    {
+        auto arena = Arena::local();
+        Tokens tokens;
+        StringViewReader reader(input);
+        reader.setMemoryResource(arena.get());
+        reader.setTokens(&tokens);
+        return tryValidate<StringViewReader>(reader);
+    }
+
+    Result<void> tryValidate(Reader &input) const override { return tryValidate<Reader>(input); }
+    Result<void> tryValidate(StringViewReader &input) const override { return tryValidate<StringViewReader>(input); }
+
+    template<is_reader R>
+    Result<void> tryValidate(R &input) const
+    {
+        auto start = input.getCursor();
+        input.skipWhitespace();
+        auto cmdStart = input.getCursor();
+        Result<void> result = ParseError {ErrorCode::UnknownCommand, cmdStart};
+        auto entry = input.tryReadStringView();
+        if (entry)
+            Level::visit(*entry, [&]<typename Node>(std::type_identity<Node>) { result = _util::StaticNode<Node>::tryValidate(input); });
+        input.setCursor(start);
+        return result;
+    }
+
+    bool isValidInput(std::string_view input) const { return tryValidate(input).hasValue(); }
+    bool isValidInput(Reader &input) const override { return tryValidate<Reader>(input).hasValue(); }
+    bool isValidInput(StringViewReader &input) const override { return tryValidate<StringViewReader>(input).hasValue(); }
+
+    using ICommandNode::listSuggestions;
+    using ICommandNode::suggestArguments;
+
+    /**
+     * @see Registry::listSuggestions
+     */
+    void listSuggestions(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const override
+    {
+        auto start = reader.getCursor();
+        auto name = reader.tryReadStringView();
+        if (name && Level::visit(*name, [&]<typename Node>(std::type_identity<Node>) { _util::StaticNode<Node>::listSuggestions(holder, reader, builder); }))
+            return;
+        reader.setCursor(start);
+        Level::suggest(reader, builder);
+    }
+
+    void suggestChildren(const TypeHolder &holder, const Reader &reader, SuggestionsBuilder &builder) const override { Level::suggest(reader, builder); }
+
+    /**
+     * @brief Check whether a root command is named or aliased name
+     */
+    static constexpr bool contains(std::string_view name) { return Level::table.find(name) != Level::keyCount; }
+
+    /**
+     * @brief There are no nodes at runtime, always empty
+     */
+    const std::vector<std::shared_ptr<ICommandNode>> &getChildren() const override
+    {
+        static const std::vector<std::shared_ptr<ICommandNode>> none;
+        return none;
+    }
+
+    /**
+     * @brief There are no nodes at runtime, always nullptr
+     */
+    const ICommandNode *findChild(std::string_view name) const override { return nullptr; }
+
+    constexpr std::string_view getName() const override { return "<root>"; }
+    constexpr std::string_view getUsage() const override { return ""; }
+    constexpr bool canUse(const TypeHolder &source) const override { return true; }
+    [[noreturn]] const std::vector<std::string> &getAliases() const override { throw std::runtime_error("Not implemented"); }
+
+    Result<void> tryExecute(TypeHolder &source, Reader &reader) const override { return ParseError {ErrorCode::InvalidCommand, reader.getCursor()}; }
+    Result<std::unique_ptr<BoundArguments>> tryBind(Reader &reader) const override { return ParseError {ErrorCode::InvalidCommand, reader.getCursor()}; }
+    Result<void> tryValidateArguments(Reader &input) const override { return ParseError {ErrorCode::InvalidCommand, input.getCursor()}; }
+    void suggestArguments(TypeHolder &holder, Reader &reader, SuggestionsBuilder &builder) const override {}
+};
+} // namespace brigadier
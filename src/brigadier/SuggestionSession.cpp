@@ -0,0 +1,94 @@
+#include <brigadier/SuggestionSession.hpp>
+#include <algorithm>
+
+void brigadier::SuggestionSession::reset()
+{
+    _input.clear();
+    _checkpoints.clear();
+    _resumedAt = 0;
+}
+
+std::vector<std::string> brigadier::SuggestionSession::listSuggestions(TypeHolder &holder, std::string_view input)
+{
+    std::vector<std::string> suggestions;
+    SuggestionsBuilder builder(suggestions);
+    listSuggestions(holder, input, builder);
+    return suggestions;
+}
+
+void brigadier::SuggestionSession::listSuggestions(TypeHolder &holder, std::string_view input, SuggestionsBuilder &builder)
+{
+    // Holding the version keeps the nodes of the checkpoints alive
+    auto tree = _registry._tree.read();
+    StringViewReader reader(input);
+
+    if (tree->version != _version) {
+        reset();
+        _version = tree->version;
+    }
+
+    // Typing usually appends or deletes at the end, a memcmp is enough for it
+    size_t common = _input.size();
+    if (!input.starts_with(_input) && !std::string_view(_input).starts_with(input))
+        common = static_cast<size_t>(std::mismatch(input.begin(), input.end(), _input.begin(), _input.end()).first - input.begin());
+    common = std::min(common, input.size());
+    // A checkpoint still holds if the token before it, and the whitespace ending that token, did not change
+    while (!_checkpoints.empty()) {
+        auto cursor = _checkpoints.back().cursor;
+        if (cursor <= common && cursor > 0 && reader.isSpace(input[cursor - 1]))
+            break;
+        _checkpoints.pop_back();
+    }
+    _input.assign(input);
+
+    if (_checkpoints.empty()) {
+        _resumedAt = 0;
+        auto name = reader.tryReadStringView();
+        auto root = name ? tree->index.find(*name) : nullptr;
+        if (root == nullptr) {
+            reader.setCursor(0);
+            _util::suggestLiterals(tree->index, holder, reader, builder);
+            return;
+        }
+        _checkpoints.push_back({root, 0, reader.getCursor()});
+    } else {
+        _resumedAt = _checkpoints.back().cursor;
+        reader.setCursor(_resumedAt);
+        // More whitespace may have been typed after the checkpoint
+        reader.skipWhitespace();
+    }
+
+    auto [node, arguments, cursor] = _checkpoints.back();
+    if (arguments == 0) {
+        while (reader.canRead()) {
+            auto start = reader.getCursor();
+            auto entry = reader.tryReadStringView();
+            auto child = entry ? node->findChild(*entry) : nullptr;
+            if (child == nullptr) {
+                reader.setCursor(start);
+                break;
+            }
+            node = child;
+            _checkpoints.push_back({node, 0, reader.getCursor()});
+        }
+        node->suggestChildren(holder, reader, builder);
+    }
+
+    if constexpr (options::metrics) {
+        if (auto counters = node->getCounters())
+            counters->add(_util::NodeCounters::Suggestions);
+    }
+    auto count = node->getArgumentCount();
+    if (count == 0) {
+        node->suggestArguments(holder, reader, builder);
+        return;
+    }
+    for (; arguments < count; ++arguments) {
+        if (!node->tryValidateArgument(arguments, reader))
+            return;
+        // Not after the last argument, which may be greedy
+        if (arguments + 1 < count)
+            _checkpoints.push_back({node, arguments + 1, reader.getCursor()});
+    }
+    node->provideSuggestions(holder, builder);
+}
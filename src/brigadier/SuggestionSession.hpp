@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <brigadier/ICommandNode.hpp>
+#include <brigadier/Registry.hpp>
+#include <brigadier/SuggestionsBuilder.hpp>
+#include <brigadier/TypeHolder.hpp>
+
+namespace brigadier {
+/**
+ * @brief Lists suggestions for successive versions of an input line, e.g. one request per keystroke
+ *
+ * The session remembers where the previous input was parsed to: the node reached after each literal
+ * and the cursor after each argument. When the new input shares a prefix with the previous one,
+ * parsing resumes from the deepest checkpoint inside that prefix instead of from the start,
+ * so that completing the end of a long line does not re-parse the whole line.
+ *
+ * Suggestions are the same as `Registry::listSuggestions`. Parsers are expected not to look past
+ * the whitespace following their argument, only the last argument of a node may be greedy.
+ *
+ * @code
+ * SuggestionSession session(registry);
+ * for (auto &line : keystrokes)
+ *     send(session.listSuggestions(player, line));
+ * @endcode
+ *
+ * @warning Not thread-safe, use one session per client. The registry must outlive the session
+ */
+class SuggestionSession {
+public:
+    explicit SuggestionSession(const Registry &registry):
+        _registry(registry)
+    {
+    }
+
+    /**
+     * @brief Stream the suggestions for the input into a builder
+     *
+     * @param holder
+     * @param input
+     * @param builder
+     */
+    void listSuggestions(TypeHolder &holder, std::string_view input, SuggestionsBuilder &builder);
+
+    [[nodiscard]] std::vector<std::string> listSuggestions(TypeHolder &holder, std::string_view input);
+
+    /**
+     * @brief Forget the previous input
+     */
+    void reset();
+
+    /**
+     * @brief Get the position the last request resumed parsing from, 0 if it started over
+     *
+     * @return size_t
+     */
+    size_t getResumedAt() const { return _resumedAt; }
+
+private:
+    struct Checkpoint {
+        const ICommandNode *node;
+        size_t arguments; ///< The number of arguments of node already validated
+        size_t cursor;
+    };
+
+private:
+    const Registry &_registry;
+    std::string _input;
+    std::vector<Checkpoint> _checkpoints;
+    uint64_t _version = 0;
+    size_t _resumedAt = 0;
+};
+} // namespace brigadier
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brigadier {
+/**
+ * @brief Receives the suggestions of a command one candidate at a time
+ *
+ * Candidates are filtered by prefix and forwarded to a sink as views, only valid during the call:
+ * nothing is allocated unless the sink copies them. Once the limit is reached `suggest` returns false
+ * and drops further candidates, so that providers can stop early.
+ *
+ * @code
+ * std::vector<std::string> suggestions;
+ * SuggestionsBuilder builder(suggestions, 10, "di");
+ * registry.listSuggestions(player, reader, builder);
+ * @endcode
+ */
+class SuggestionsBuilder {
+public:
+    static constexpr size_t unlimited = std::numeric_limits<size_t>::max();
+
+    /**
+     * @param sink Called with each accepted candidate, must outlive the builder
+     * @param limit The maximum number of candidates to accept
+     * @param prefix Only the candidates starting with it are accepted
+     */
+    template<typename F>
+        requires std::invocable<F &, std::string_view>
+    explicit SuggestionsBuilder(F &sink, size_t limit = unlimited, std::string_view prefix = {}):
+        _sink([](void *context, std::string_view candidate) { (*static_cast<F *>(context))(candidate); }),
+        _context(const_cast<void *>(static_cast<const void *>(std::addressof(sink)))),
+        _limit(limit),
+        _prefix(prefix)
+    {
+    }
+
+    /**
+     * @param suggestions Where the accepted candidates are copied, must outlive the builder
+     * @param limit The maximum number of candidates to accept
+     * @param prefix Only the candidates starting with it are accepted
+     */
+    explicit SuggestionsBuilder(std::vector<std::string> &suggestions, size_t limit = unlimited, std::string_view prefix = {}):
+        _sink([](void *context, std::string_view candidate) { static_cast<std::vector<std::string> *>(context)->emplace_back(candidate); }),
+        _context(&suggestions),
+        _limit(limit),
+        _prefix(prefix)
+    {
+    }
+
+    SuggestionsBuilder(const SuggestionsBuilder &) = delete;
+    SuggestionsBuilder &operator=(const SuggestionsBuilder &) = delete;
+
+    /**
+     * @brief Offer a candidate
+     *
+     * @param candidate
+     * @return bool false once the limit is reached, the provider should stop there
+     */
+    bool suggest(std::string_view candidate)
+    {
+        if (isFull())
+            return false;
+        if (!matches(candidate))
+            return true;
+        _sink(_context, candidate);
+        ++_count;
+        return !isFull();
+    }
+
+    /**
+     * @brief Compare ASCII letters case-insensitively, for the prefix and the completion of literals
+     *
+     * @param caseInsensitive
+     * @return SuggestionsBuilder&
+     */
+    SuggestionsBuilder &setCaseInsensitive(bool caseInsensitive)
+    {
+        _caseInsensitive = caseInsensitive;
+        return *this;
+    }
+
+    bool isCaseInsensitive() const { return _caseInsensitive; }
+    bool isFull() const { return _count >= _limit; }
+    std::string_view getPrefix() const { return _prefix; }
+    size_t getCount() const { return _count; }
+    size_t getLimit() const { return _limit; }
+
+private:
+    bool matches(std::string_view candidate) const
+    {
+        if (!_caseInsensitive)
+            return candidate.starts_with(_prefix);
+        auto fold = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+        return candidate.size() >= _prefix.size() && std::equal(_prefix.begin(), _prefix.end(), candidate.begin(), [&](char p, char c) { return fold(p) == fold(c); });
+    }
+
+private:
+    void (*_sink)(void *, std::string_view);
+    void *_context;
+    size_t _limit;
+    size_t _count = 0;
+    std::string_view _prefix;
+    bool _caseInsensitive = false;
+};
+} // namespace brigadier
@@ -0,0 +1,138 @@
+#include <brigadier/Tracing.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fmt/format.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+/**
+ * A ring of events written by a single thread
+ */
+class TraceRing {
+public:
+    TraceRing(size_t capacity, uint32_t thread):
+        _events(std::bit_ceil(std::max<size_t>(capacity, 1))),
+        _thread(thread)
+    {
+    }
+
+    void push(const brigadier::TraceEvent &event)
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+        _events[head & (_events.size() - 1)] = event;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * Visit the events from the oldest to the most recent
+     */
+    template<typename F>
+    void forEach(F &&f) const
+    {
+        auto head = _head.load(std::memory_order_acquire);
+        auto first = head > _events.size() ? head - _events.size() : 0;
+        for (auto i = first; i < head; ++i)
+            f(_events[i & (_events.size() - 1)]);
+    }
+
+    uint32_t getThread() const { return _thread; }
+
+private:
+    std::vector<brigadier::TraceEvent> _events;
+    std::atomic<uint64_t> _head {0};
+    uint32_t _thread;
+};
+
+struct TraceState {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    size_t capacity = 4096;
+    std::atomic<uint64_t> generation {1}; ///< Incremented by each start, threads then replace their ring
+    std::atomic<int64_t> origin {0};    ///< The time of the last start
+};
+
+int64_t steadyNow() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+TraceState &state()
+{
+    static TraceState state;
+    return state;
+}
+
+uint32_t threadId()
+{
+    static std::atomic<uint32_t> next {1};
+    thread_local const uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void writeEscaped(std::ostream &out, std::string_view text)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+        else
+            out << c;
+    }
+}
+} // namespace
+
+void brigadier::Tracer::start(size_t capacity)
+{
+    if constexpr (!options::tracing)
+        return;
+    auto &trace = state();
+    std::lock_guard lock(trace.mutex);
+    trace.rings.clear();
+    trace.capacity = capacity;
+    trace.origin.store(steadyNow(), std::memory_order_relaxed);
+    trace.generation.fetch_add(1, std::memory_order_release);
+    _recording.store(true, std::memory_order_release);
+}
+
+void brigadier::Tracer::stop() { _recording.store(false, std::memory_order_release); }
+
+int64_t brigadier::Tracer::now() { return steadyNow() - state().origin.load(std::memory_order_relaxed); }
+
+void brigadier::Tracer::record(const TraceEvent &event)
+{
+    thread_local std::shared_ptr<TraceRing> ring;
+    thread_local uint64_t generation = 0;
+
+    auto &trace = state();
+    auto current = trace.generation.load(std::memory_order_acquire);
+    if (generation != current) {
+        std::lock_guard lock(trace.mutex);
+        ring = std::make_shared<TraceRing>(trace.capacity, threadId());
+        trace.rings.push_back(ring);
+        generation = trace.generation.load(std::memory_order_relaxed);
+    }
+    ring->push(event);
+}
+
+void brigadier::Tracer::writeChromeTrace(std::ostream &out)
+{
+    auto &trace = state();
+    std::lock_guard lock(trace.mutex);
+    const char *separator = "\n";
+    out << "{\"traceEvents\": [";
+    for (auto &ring : trace.rings) {
+        ring->forEach([&](const TraceEvent &event) {
+            out << separator << "  {\"name\": \"";
+            writeEscaped(out, event.name);
+            // Chrome traces count in microseconds
+            out << fmt::format(
+                "\", \"cat\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}, \"args\": {{\"begin\": {}, \"end\": {}, \"outcome\": \"{}\"}}}}",
+                event.category, ring->getThread(), double(event.start) / 1000.0, double(event.duration) / 1000.0, event.begin, event.end, getErrorMessage(event.outcome)
+            );
+            separator = ",\n";
+        });
+    }
+    out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+}
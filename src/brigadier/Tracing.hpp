@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+
+#include <brigadier/Result.hpp>
+#include <brigadier/TypeHolder.hpp>
+#include <brigadier/options.hpp>
+
+namespace brigadier {
+/**
+ * @brief A span recorded by the `Tracer`
+ */
+struct TraceEvent {
+    static constexpr size_t nameCapacity = 55;
+
+    char name[nameCapacity + 1]; ///< Truncated copy, nodes and inputs may be gone when the trace is written
+    const char *category;        ///< "registry", "node", "parser" or "suggestions"
+    int64_t start;               ///< Nanoseconds since `Tracer::start`
+    int64_t duration;            ///< Nanoseconds
+    uint32_t begin;              ///< Cursor before the span
+    uint32_t end;                ///< Cursor after the span
+    ErrorCode outcome;
+};
+
+/**
+ * @brief Records where the time of a dispatch goes, into a Chrome trace / Perfetto JSON file
+ *
+ * While recording, `Registry::parse`, the nodes, the parsers and the suggestion providers each record
+ * a span with their name, the cursor range they read and their outcome. Each thread writes into its own
+ * ring buffer, without locking: once full, the oldest events of the thread are overwritten.
+ *
+ * Requires `options::tracing` (CMake `ENABLE_TRACING`): otherwise nothing is recorded, and spans compile to nothing.
+ * When compiled in but not recording, a span costs one relaxed atomic load.
+ *
+ * @code
+ * Tracer::start();
+ * registry.parse(player, "give steve diamond 64");
+ * Tracer::stop();
+ * std::ofstream file("trace.json");
+ * Tracer::writeChromeTrace(file); // open in ui.perfetto.dev or chrome://tracing
+ * @endcode
+ */
+class Tracer {
+public:
+    /**
+     * @brief Drop the events recorded so far and start recording
+     *
+     * @param capacity The number of events kept per thread, rounded up to a power of two
+     */
+    static void start(size_t capacity = 4096);
+
+    /**
+     * @brief Stop recording, the events are kept until the next `start`
+     */
+    static void stop();
+
+    static bool isRecording()
+    {
+        if constexpr (options::tracing)
+            return _recording.load(std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief Write the recorded events as a Chrome trace
+     *
+     * @warning Call it after `stop`, once the dispatches that were running are over
+     *
+     * @param out
+     */
+    static void writeChromeTrace(std::ostream &out);
+
+    /**
+     * @brief Nanoseconds since `start`
+     */
+    static int64_t now();
+
+    /**
+     * @brief Append an event to the ring buffer of the calling thread
+     */
+    static void record(const TraceEvent &event);
+
+private:
+    static inline std::atomic<bool> _recording = false;
+};
+
+namespace _util {
+/**
+ * @brief Get the demangled name of T without the brigadier namespace, computed once
+ */
+template<typename T>
+std::string_view typeName()
+{
+    static const std::string name = [] {
+        std::string name = GET_NAME(typeid(T));
+        for (auto at = name.find("brigadier::"); at != std::string::npos; at = name.find("brigadier::", at))
+            name.erase(at, sizeof("brigadier::") - 1);
+        return name;
+    }();
+    return name;
+}
+
+/**
+ * @brief Records a span from its construction to `close`, if the `Tracer` is recording
+ *
+ * The name is only computed when recording. A span that is not closed, e.g. because of an exception, is dropped.
+ */
+class TraceSpan {
+public:
+    /**
+     * @param category A string literal
+     * @param begin The cursor where the span starts
+     * @param name Called for the name of the span
+     */
+    template<typename F>
+    TraceSpan(const char *category, size_t begin, F &&name)
+    {
+        if constexpr (options::tracing) {
+            if (Tracer::isRecording()) {
+                _category = category;
+                _name = name();
+                _begin = begin;
+                _start = Tracer::now();
+            }
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    /**
+     * @brief Record the span
+     *
+     * @param end The cursor where the span ends
+     * @param outcome
+     */
+    void close(size_t end, ErrorCode outcome)
+    {
+        if constexpr (options::tracing) {
+            if (_category == nullptr)
+                return;
+            TraceEvent event;
+            auto length = _name.copy(event.name, TraceEvent::nameCapacity);
+            event.name[length] = '\0';
+            event.category = std::exchange(_category, nullptr);
+            event.start = _start;
+            event.duration = Tracer::now() - _start;
+            event.begin = static_cast<uint32_t>(_begin);
+            event.end = static_cast<uint32_t>(end);
+            event.outcome = outcome;
+            Tracer::record(event);
+        }
+    }
+
+    /**
+     * @brief Record the span with the outcome of result, ending at the cursor of reader
+     */
+    template<typename T, typename R>
+    void close(const Result<T> &result, const R &reader)
+    {
+        if constexpr (options::tracing) {
+            if (_category != nullptr)
+                close(reader.getCursor(), result ? ErrorCode::None : result.error().code);
+        }
+    }
+
+private:
+    const char *_category = nullptr;
+    std::string_view _name;
+    size_t _begin = 0;
+    int64_t _start = 0;
+};
+} // namespace _util
+} // namespace brigadier
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <brigadier/Result.hpp>
 #include <brigadier/reader/Reader.hpp>
 #include <cstddef>
 #include <fmt/format.h>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #define POPULATE_BASIC_EXCEPTION(name, exception) \
 public:                                           \
@@ -39,15 +41,94 @@ DEFINE_EXCEPTION(DispatcherException);
 //* Reader
 DEFINE_EXCEPTION(ReaderException);
 
-DEFINE_EXCEPTION_FROM_C(CommandSyntaxException, ReaderException, (const std::string &message, Reader &reader), {
-    return fmt::format("{} at position {}", message, reader.getCursor());
-});
+/**
+ * @brief An invalid input
+ *
+ * The exception owns a copy of the input and its rendered message, so both outlive the buffer that was parsed.
+ * Inside the library errors travel as `Result`s, which only hold an error code and a cursor:
+ * an exception is only built when an error leaves through a throwing entry point such as `parse`.
+ */
+class CommandSyntaxException : public ReaderException {
+public:
+    CommandSyntaxException(char const *const message) throw():
+        ReaderException(message),
+        _error {ErrorCode::InvalidArgument, 0}
+    {
+    }
+
+    CommandSyntaxException(const std::string &message) throw():
+        ReaderException(message),
+        _error {ErrorCode::InvalidArgument, 0}
+    {
+    }
+
+    CommandSyntaxException(const std::string &message, const Reader &reader) throw():
+        ReaderException(fmt::format("{} at position {}", message, reader.getCursor())),
+        _error {ErrorCode::InvalidArgument, reader.getCursor()}
+    {
+    }
+
+    CommandSyntaxException(const ParseError &error, std::string_view input):
+        ReaderException(fmt::format("{} at position {} whilst reading {}", getErrorMessage(error.code), error.cursor, input)),
+        _error(error),
+        _input(input)
+    {
+    }
+
+    CommandSyntaxException(const ParseError &error, const Reader &reader):
+        CommandSyntaxException(error, reader.getStringView())
+    {
+    }
+
+    /**
+     * @brief Get the error code and cursor of the exception
+     *
+     * @return const ParseError&
+     */
+    const ParseError &getError() const { return _error; }
+
+    /**
+     * @brief Get the input the error happened in
+     *
+     * @return std::string_view Empty for exceptions built from a message
+     */
+    std::string_view getInput() const { return _input; }
+
+private:
+    ParseError _error;
+    std::string _input;
+};
+
+/**
+ * @brief Unwrap the value of a result, throwing its error as a `CommandSyntaxException`
+ *
+ * @throw CommandSyntaxException If the result holds an error
+ */
+template<typename T>
+T valueOrThrow(Result<T> &&result, const Reader &reader)
+{
+    if (!result)
+        throw CommandSyntaxException(result.error(), reader);
+    return std::move(result).value();
+}
+
+/**
+ * @see valueOrThrow
+ */
+inline void valueOrThrow(Result<void> &&result, const Reader &reader)
+{
+    if (!result)
+        throw CommandSyntaxException(result.error(), reader);
+}
 
 //* Parser
 DEFINE_EXCEPTION(ParserException);
 
 DEFINE_EXCEPTION_FROM(ArgumentException, ParserException);
 
+//* Builder
+DEFINE_EXCEPTION(BuilderException);
+
 //* TypeHolder
 DEFINE_EXCEPTION(TypeHolderException);
 
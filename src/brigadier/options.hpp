@@ -1,3 +1,43 @@
 #pragma once
 
-// TODO: implement this file
+#include <cstddef>
+
+/**
+ * @brief Compile-time options, set through the CMake options of the same name
+ *
+ * They change the layout of the nodes: the library and everything including it must agree on them,
+ * which is why CMake defines them on the library as PUBLIC.
+ */
+namespace brigadier::options {
+/**
+ * @brief Per-node dispatch counters and latency histograms, see `Registry::getMetrics`
+ *
+ * Enabled by `ENABLE_METRICS`, when disabled nothing is recorded nor stored.
+ */
+#ifdef BRIGADIER_ENABLE_METRICS
+inline constexpr bool metrics = true;
+#else
+inline constexpr bool metrics = false;
+#endif
+
+/**
+ * @brief Spans recorded by the `Tracer`
+ *
+ * Enabled by `ENABLE_TRACING`, when disabled the spans compile to nothing.
+ */
+#ifdef BRIGADIER_ENABLE_TRACING
+inline constexpr bool tracing = true;
+#else
+inline constexpr bool tracing = false;
+#endif
+
+/**
+ * @brief The bytes of captures stored inside a node for each callback, see `Function`
+ *
+ * Callbacks capturing more are allocated, define `BRIGADIER_CALLBACK_CAPACITY` to change it.
+ */
+#ifndef BRIGADIER_CALLBACK_CAPACITY
+#define BRIGADIER_CALLBACK_CAPACITY 32
+#endif
+inline constexpr size_t callbackCapacity = BRIGADIER_CALLBACK_CAPACITY;
+} // namespace brigadier::options
@@ -6,7 +6,19 @@ namespace brigadier {
 struct BoolParser : public Parser {
     using type = bool;
 
-    static bool parse(Reader &reader) { return reader.readBool(); }
+    static constexpr bool canStartWith(char c, const CharClasses &) { return c == 't' || c == 'f' || c == '0' || c == '1'; }
+
+    template<is_reader R>
+    static Result<bool> tryParse(R &reader)
+    {
+        return reader.tryReadBool();
+    }
+
+    template<is_reader R>
+    static bool parse(R &reader)
+    {
+        return reader.readBool();
+    }
 };
 
 } // namespace brigadier
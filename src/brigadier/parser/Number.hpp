@@ -1,40 +1,54 @@
 #pragma once
 
 #include <brigadier/Parser.hpp>
+#include <brigadier/reader/NumberScanner.hpp>
+#include <brigadier/reader/Scan.hpp>
 #include <limits>
+#include <type_traits>
 
 namespace brigadier {
-template<typename T>
+/**
+ * @brief A parser of numbers of type T
+ *
+ * @code
+ * CommandNodeBuilder("give").expectArg<NumberParser<int>>("count");
+ * CommandNodeBuilder("color").expectArg<NumberParser<int, NumberFormat::Hex>>("rgb");
+ * CommandNodeBuilder("scale").expectArg<NumberParser<double, NumberFormat::Exponent | NumberFormat::Underscores>>("factor");
+ * @endcode
+ *
+ * @tparam T An arithmetic type
+ * @tparam Format The syntaxes accepted on top of plain decimal numbers
+ */
+template<typename T, NumberFormat Format = NumberFormat::Decimal>
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
 struct NumberParser : public Parser {
-    NumberParser() = delete;
-};
-
-template<>
-struct NumberParser<int> : public Parser {
-    using type = int;
-
-    static int parse(Reader &reader) { return reader.readInt(); }
-};
-
-template<>
-struct NumberParser<long> : public Parser {
-    using type = long;
-
-    static long parse(Reader &reader) { return reader.readLong(); }
-};
-
-template<>
-struct NumberParser<float> : public Parser {
-    using type = float;
-
-    static float parse(Reader &reader) { return reader.readFloat(); }
-};
-
-template<>
-struct NumberParser<double> : public Parser {
-    using type = double;
-
-    static double parse(Reader &reader) { return reader.readDouble(); }
+    using type = T;
+
+    static constexpr bool canStartWith(char c, const CharClasses &)
+    {
+        return _util::isDigit(c, 10) || c == '-' || c == '+' || (std::is_floating_point_v<T> && c == '.');
+    }
+
+    template<is_reader R>
+    static Result<T> tryParse(R &reader)
+    {
+        if constexpr (Format == NumberFormat::Decimal && std::is_same_v<T, int>)
+            return reader.tryReadInt();
+        else if constexpr (Format == NumberFormat::Decimal && std::is_same_v<T, long>)
+            return reader.tryReadLong();
+        else if constexpr (Format == NumberFormat::Decimal && std::is_same_v<T, float>)
+            return reader.tryReadFloat();
+        else if constexpr (Format == NumberFormat::Decimal && std::is_same_v<T, double>)
+            return reader.tryReadDouble();
+        else
+            return _util::tryReadNumber<T>(reader, Format);
+    }
+
+    template<is_reader R>
+    static T parse(R &reader)
+    {
+        return valueOrThrow(tryParse(reader), reader);
+    }
 };
 
 } // namespace brigadier
@@ -3,26 +3,167 @@
 #include "brigadier/exceptions.hpp"
 #include <brigadier/Parser.hpp>
 #include <brigadier/reader/Reader.hpp>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 namespace brigadier {
 struct StringParser : public Parser {
     using type = std::string;
 
-    static std::string parse(Reader &reader) { return reader.readString(); }
+    static constexpr bool canStartWith(char c, const CharClasses &classes) { return classes.is(c, CharClasses::Unquoted) || classes.is(c, CharClasses::Quote); }
+
+    template<is_reader R>
+    static Result<std::string> tryParse(R &reader)
+    {
+        auto str = reader.tryReadStringView();
+        if (!str)
+            return str.error();
+        return std::string(*str);
+    }
+
+    template<is_reader R>
+    static Result<void> tryValidate(R &reader)
+    {
+        auto str = reader.tryReadStringView();
+        if (!str)
+            return str.error();
+        return {};
+    }
+
+    template<is_reader R>
+    static std::string parse(R &reader)
+    {
+        return reader.readString();
+    }
 };
 
-struct GreedyStringParser : public Parser {
-    using type = std::string;
+/**
+ * @brief Same as `StringParser` but without copying the argument
+ *
+ * @warning The view points into the input of the reader, it must not outlive it
+ */
+struct StringViewParser : public Parser {
+    using type = std::string_view;
 
-    static std::string parse(Reader &reader)
+    static constexpr bool canStartWith(char c, const CharClasses &classes) { return StringParser::canStartWith(c, classes); }
+
+    template<is_reader R>
+    static Result<std::string_view> tryParse(R &reader)
     {
-        auto str = reader.getRemaining();
+        return reader.tryReadStringView();
+    }
+
+    template<is_reader R>
+    static std::string_view parse(R &reader)
+    {
+        return reader.readStringView();
+    }
+};
+
+/**
+ * @brief Same as `GreedyStringParser` but without copying the argument
+ *
+ * @warning The view points into the input of the reader, it must not outlive it
+ */
+struct GreedyStringViewParser : public Parser {
+    using type = std::string_view;
+
+    template<is_reader R>
+    static Result<std::string_view> tryParse(R &reader)
+    {
+        auto str = reader.getRemainingView();
         if (str.empty())
-            throw CommandSyntaxException("Expected string", reader);
+            return ParseError {ErrorCode::ExpectedString, reader.getCursor()};
         reader.setCursor(reader.getTotalLength());
         return str;
     }
+
+    template<is_reader R>
+    static std::string_view parse(R &reader)
+    {
+        return valueOrThrow(tryParse(reader), reader);
+    }
+};
+
+struct GreedyStringParser : public Parser {
+    using type = std::string;
+
+    template<is_reader R>
+    static Result<std::string> tryParse(R &reader)
+    {
+        auto str = GreedyStringViewParser::tryParse(reader);
+        if (!str)
+            return str.error();
+        return std::string(*str);
+    }
+
+    template<is_reader R>
+    static Result<void> tryValidate(R &reader)
+    {
+        auto str = GreedyStringViewParser::tryParse(reader);
+        if (!str)
+            return str.error();
+        return {};
+    }
+
+    template<is_reader R>
+    static std::string parse(R &reader)
+    {
+        return valueOrThrow(tryParse(reader), reader);
+    }
+};
+
+/**
+ * @brief Same as `StringParser` but the string is allocated from the memory resource of the reader
+ *
+ * `Registry::parse` gives the reader a thread-local `Arena`, so no heap allocation happens for the argument.
+ *
+ * @warning The string must not outlive the parse: copy it into a `std::string` to keep it
+ */
+struct PmrStringParser : public Parser {
+    using type = std::pmr::string;
+
+    static constexpr bool canStartWith(char c, const CharClasses &classes) { return StringParser::canStartWith(c, classes); }
+
+    template<is_reader R>
+    static Result<std::pmr::string> tryParse(R &reader)
+    {
+        auto str = reader.tryReadStringView();
+        if (!str)
+            return str.error();
+        return std::pmr::string(*str, reader.getMemoryResource());
+    }
+
+    template<is_reader R>
+    static Result<void> tryValidate(R &reader)
+    {
+        return StringParser::tryValidate(reader);
+    }
+};
+
+/**
+ * @brief Same as `GreedyStringParser` but the string is allocated from the memory resource of the reader
+ *
+ * @see PmrStringParser
+ */
+struct GreedyPmrStringParser : public Parser {
+    using type = std::pmr::string;
+
+    template<is_reader R>
+    static Result<std::pmr::string> tryParse(R &reader)
+    {
+        auto str = GreedyStringViewParser::tryParse(reader);
+        if (!str)
+            return str.error();
+        return std::pmr::string(*str, reader.getMemoryResource());
+    }
+
+    template<is_reader R>
+    static Result<void> tryValidate(R &reader)
+    {
+        return GreedyStringParser::tryValidate(reader);
+    }
 };
 
 } // namespace brigadier
@@ -1,4 +1,8 @@
 #pragma once
 
+#include <brigadier/reader/CharClasses.hpp>
 #include <brigadier/reader/Reader.hpp>
+#include <brigadier/reader/ScanKernels.hpp>
 #include <brigadier/reader/StringReader.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
+#include <brigadier/reader/Tokens.hpp>
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace brigadier {
+/**
+ * @brief What each of the 256 byte values is to a reader: whitespace, part of an unquoted string, or a quote
+ *
+ * Readers classify characters with one table lookup instead of comparisons or the locale-dependent `std::isspace`.
+ * For the vectorized scanners, each class is also kept as a short list of byte ranges, compared 16 bytes
+ * at a time with SSE2, and as two 16-entry tables indexed by the low and high nibble of a byte, looked up
+ * 32 bytes at a time with AVX2. A class neither form can hold is still honored, by the scalar scanner.
+ *
+ * @code
+ * static constexpr auto classes = CharClasses::standard().set(":/", CharClasses::Unquoted); // namespaced ids
+ * reader.setCharClasses(&classes);
+ * @endcode
+ */
+class CharClasses {
+public:
+    enum Class : uint8_t {
+        Space = 1 << 0,
+        Unquoted = 1 << 1,
+        Quote = 1 << 2,
+    };
+
+    static constexpr size_t maxRanges = 8;
+
+    /**
+     * @brief Inclusive byte ranges, in ascending order
+     */
+    struct Ranges {
+        uint8_t count = 0; ///< Above maxRanges if the class has too many ranges to be vectorized
+        std::array<uint8_t, maxRanges> first {};
+        std::array<uint8_t, maxRanges> width {}; ///< last - first
+
+        constexpr bool isVectorizable() const { return count <= maxRanges; }
+    };
+
+    /**
+     * @brief A byte b is in the class when `low[b & 0xF] & high[b >> 4]` is not zero
+     *
+     * Each bit stands for a set of low nibbles, shared by the high nibbles with the same set:
+     * it holds any class with at most 8 distinct sets.
+     */
+    struct Nibbles {
+        bool exact = false; ///< Whether the tables hold the class
+        std::array<uint8_t, 16> low {};
+        std::array<uint8_t, 16> high {};
+    };
+
+    /**
+     * @brief No character in any class
+     */
+    constexpr CharClasses() = default;
+
+    /**
+     * @brief The classes of Brigadier: ASCII whitespace, `0-9A-Za-z_-.+` unquoted, and double and single quotes
+     */
+    static constexpr CharClasses standard()
+    {
+        CharClasses classes;
+        classes.set(" \t\n\v\f\r", Space);
+        classes.set("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz_-.+", Unquoted);
+        classes.set("\"'", Quote);
+        return classes;
+    }
+
+    constexpr bool is(char c, Class cls) const { return (_table[static_cast<unsigned char>(c)] & cls) != 0; }
+
+    /**
+     * @brief Add the characters to a class, or remove them from it
+     *
+     * @param chars
+     * @param cls
+     * @param enabled
+     * @return CharClasses&
+     */
+    constexpr CharClasses &set(std::string_view chars, Class cls, bool enabled = true)
+    {
+        for (auto c : chars) {
+            auto &entry = _table[static_cast<unsigned char>(c)];
+            entry = enabled ? (entry | cls) : (entry & ~cls);
+        }
+        updateRanges();
+        updateNibbles();
+        return *this;
+    }
+
+    constexpr const Ranges &getRanges(Class cls) const { return _ranges[indexOf(cls)]; }
+    constexpr const Nibbles &getNibbles(Class cls) const { return _nibbles[indexOf(cls)]; }
+
+private:
+    static constexpr size_t indexOf(Class cls) { return cls == Space ? 0 : cls == Unquoted ? 1 : 2; }
+
+    constexpr void updateRanges()
+    {
+        for (size_t i = 0; i < _ranges.size(); ++i) {
+            auto cls = static_cast<uint8_t>(1 << i);
+            Ranges ranges;
+            for (size_t c = 0; c < 256; ++c) {
+                if ((_table[c] & cls) == 0 || (c > 0 && (_table[c - 1] & cls) != 0))
+                    continue;
+                auto last = c;
+                while (last + 1 < 256 && (_table[last + 1] & cls) != 0)
+                    ++last;
+                if (ranges.count < maxRanges) {
+                    ranges.first[ranges.count] = static_cast<uint8_t>(c);
+                    ranges.width[ranges.count] = static_cast<uint8_t>(last - c);
+                }
+                ++ranges.count;
+            }
+            _ranges[i] = ranges;
+        }
+    }
+
+    constexpr void updateNibbles()
+    {
+        for (size_t i = 0; i < _nibbles.size(); ++i) {
+            auto cls = static_cast<uint8_t>(1 << i);
+            Nibbles nibbles;
+            std::array<uint16_t, 8> sets {};
+            size_t setCount = 0;
+            nibbles.exact = true;
+            for (size_t high = 0; high < 16; ++high) {
+                uint16_t set = 0;
+                for (size_t low = 0; low < 16; ++low) {
+                    if ((_table[high << 4 | low] & cls) != 0)
+                        set |= static_cast<uint16_t>(1 << low);
+                }
+                if (set == 0)
+                    continue;
+                size_t bit = 0;
+                while (bit < setCount && sets[bit] != set)
+                    ++bit;
+                if (bit == sets.size()) {
+                    nibbles.exact = false;
+                    break;
+                }
+                if (bit == setCount)
+                    sets[setCount++] = set;
+                nibbles.high[high] |= static_cast<uint8_t>(1 << bit);
+            }
+            for (size_t bit = 0; bit < setCount; ++bit) {
+                for (size_t low = 0; low < 16; ++low) {
+                    if ((sets[bit] >> low) & 1)
+                        nibbles.low[low] |= static_cast<uint8_t>(1 << bit);
+                }
+            }
+            _nibbles[i] = nibbles;
+        }
+    }
+
+private:
+    std::array<uint8_t, 256> _table {};
+    std::array<Ranges, 3> _ranges {};
+    std::array<Nibbles, 3> _nibbles {};
+};
+
+/**
+ * @brief The classes readers use unless given others
+ */
+inline constexpr CharClasses standardCharClasses = CharClasses::standard();
+} // namespace brigadier
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace brigadier {
+/**
+ * @brief Syntaxes accepted when scanning a number
+ *
+ * `Decimal` accepts `[-+]?[0-9]+` for integers and `[-+]?[0-9]*\.?[0-9]+` for floating point numbers,
+ * the other formats are opt-in and can be combined with `|`.
+ */
+enum class NumberFormat : uint8_t {
+    Decimal = 0,
+    Hex = 1 << 0, ///< `0x` prefixed integers, e.g. `0x1F`
+    Underscores = 1 << 1, ///< `_` between two digits, e.g. `1_000_000`
+    Exponent = 1 << 2, ///< Scientific notation for floating point numbers, e.g. `1.5e3`
+};
+
+constexpr NumberFormat operator|(NumberFormat lhs, NumberFormat rhs) { return static_cast<NumberFormat>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs)); }
+
+constexpr bool hasFormat(NumberFormat format, NumberFormat flag) { return (static_cast<uint8_t>(format) & static_cast<uint8_t>(flag)) != 0; }
+
+/**
+ * @brief Why a number could not be scanned
+ */
+enum class NumberError : uint8_t {
+    None,
+    InvalidSyntax, ///< The input does not start with a number
+    Overflow, ///< The number does not fit in the requested type
+    TrailingGarbage, ///< The number is directly followed by other characters of the same token
+};
+
+/**
+ * @brief The result of a number scan
+ *
+ * @tparam T The scanned type
+ */
+template<typename T>
+struct NumberScan {
+    T value;
+    NumberError error;
+    size_t length; ///< The number of characters of the number, 0 on syntax errors
+
+    constexpr explicit operator bool() const { return error == NumberError::None; }
+};
+
+namespace _util {
+constexpr bool isDigit(char c, int base)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0' < base;
+    return base == 16 && ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'));
+}
+
+/**
+ * @brief Skip the digits starting at pos, underscores are only allowed between two digits
+ *
+ * @return size_t The position after the last digit
+ */
+constexpr size_t scanDigits(std::string_view input, size_t pos, int base, bool underscores, bool &hasUnderscores)
+{
+    auto start = pos;
+
+    while (pos < input.size()) {
+        if (isDigit(input[pos], base)) {
+            ++pos;
+        } else if (underscores && input[pos] == '_' && pos > start && pos + 1 < input.size() && isDigit(input[pos + 1], base)) {
+            hasUnderscores = true;
+            ++pos;
+        } else {
+            break;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief Call f with the input stripped of its underscores, on the stack for usual sizes
+ */
+template<typename F>
+auto withoutUnderscores(std::string_view input, F &&f)
+{
+    char buffer[128];
+    std::string fallback;
+    char *out = buffer;
+
+    if (input.size() > sizeof(buffer)) {
+        fallback.resize(input.size());
+        out = fallback.data();
+    }
+    size_t size = 0;
+    for (auto c : input) {
+        if (c != '_')
+            out[size++] = c;
+    }
+    return f(std::string_view(out, size));
+}
+
+template<typename T>
+NumberScan<T> convertInteger(std::string_view digits, int base, bool negative, size_t length)
+{
+    using U = std::make_unsigned_t<T>;
+    U magnitude {};
+
+    auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), magnitude, base);
+    if (ec == std::errc::result_out_of_range)
+        return {T {}, NumberError::Overflow, length};
+    if (ec != std::errc() || ptr != digits.data() + digits.size())
+        return {T {}, NumberError::InvalidSyntax, 0};
+    if (!negative) {
+        if (magnitude > static_cast<U>(std::numeric_limits<T>::max()))
+            return {T {}, NumberError::Overflow, length};
+        return {static_cast<T>(magnitude), NumberError::None, length};
+    }
+    if constexpr (std::is_signed_v<T>) {
+        if (magnitude > static_cast<U>(std::numeric_limits<T>::max()) + 1u)
+            return {T {}, NumberError::Overflow, length};
+        return {static_cast<T>(U {} - magnitude), NumberError::None, length};
+    } else {
+        if (magnitude != 0)
+            return {T {}, NumberError::Overflow, length};
+        return {T {}, NumberError::None, length};
+    }
+}
+
+template<typename T>
+NumberScan<T> convertFloating(std::string_view number, std::chars_format format, size_t length)
+{
+    T value {};
+
+    auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), value, format);
+    if (ec == std::errc::result_out_of_range)
+        return {T {}, NumberError::Overflow, length};
+    if (ec != std::errc() || ptr != number.data() + number.size())
+        return {T {}, NumberError::InvalidSyntax, 0};
+    return {value, NumberError::None, length};
+}
+} // namespace _util
+
+/**
+ * @brief Scan a number at the start of input in a single pass, without allocating nor throwing
+ *
+ * Only the syntax of the number itself is checked, the caller decides what may follow it.
+ * Hexadecimal is only supported for integers, exponents only for floating point numbers.
+ *
+ * @tparam T An arithmetic type
+ * @param input
+ * @param format
+ * @return NumberScan<T>
+ */
+template<typename T>
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+NumberScan<T> scanNumber(std::string_view input, NumberFormat format = NumberFormat::Decimal)
+{
+    bool underscores = hasFormat(format, NumberFormat::Underscores);
+    bool hasUnderscores = false;
+    bool negative = false;
+    size_t pos = 0;
+
+    if (pos < input.size() && (input[pos] == '-' || input[pos] == '+'))
+        negative = input[pos++] == '-';
+    if constexpr (std::is_integral_v<T>) {
+        int base = 10;
+        if (hasFormat(format, NumberFormat::Hex) && input.size() > pos + 2 && input[pos] == '0' && (input[pos + 1] == 'x' || input[pos + 1] == 'X') && _util::isDigit(input[pos + 2], 16)) {
+            base = 16;
+            pos += 2;
+        }
+        auto start = pos;
+        pos = _util::scanDigits(input, pos, base, underscores, hasUnderscores);
+        if (pos == start)
+            return {T {}, NumberError::InvalidSyntax, 0};
+        auto digits = input.substr(start, pos - start);
+        if (hasUnderscores) {
+            return _util::withoutUnderscores(digits, [&](std::string_view stripped) {
+                return _util::convertInteger<T>(stripped, base, negative, pos);
+            });
+        }
+        return _util::convertInteger<T>(digits, base, negative, pos);
+    } else {
+        auto start = pos;
+        auto chars = std::chars_format::fixed;
+        pos = _util::scanDigits(input, pos, 10, underscores, hasUnderscores);
+        if (pos + 1 < input.size() && input[pos] == '.' && _util::isDigit(input[pos + 1], 10))
+            pos = _util::scanDigits(input, pos + 1, 10, underscores, hasUnderscores);
+        if (pos == start)
+            return {T {}, NumberError::InvalidSyntax, 0};
+        if (hasFormat(format, NumberFormat::Exponent) && pos < input.size() && (input[pos] == 'e' || input[pos] == 'E')) {
+            auto exponent = pos + 1;
+            bool unused = false;
+            if (exponent < input.size() && (input[exponent] == '-' || input[exponent] == '+'))
+                ++exponent;
+            auto end = _util::scanDigits(input, exponent, 10, false, unused);
+            if (end > exponent) {
+                pos = end;
+                chars = std::chars_format::general;
+            }
+        }
+        // from_chars accepts a leading '-' but not a leading '+'
+        auto number = input.substr(negative ? 0 : start, pos - (negative ? 0 : start));
+        if (hasUnderscores) {
+            return _util::withoutUnderscores(number, [&](std::string_view stripped) {
+                return _util::convertFloating<T>(stripped, chars, pos);
+            });
+        }
+        return _util::convertFloating<T>(number, chars, pos);
+    }
+}
+
+} // namespace brigadier
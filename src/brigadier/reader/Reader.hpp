@@ -1,12 +1,19 @@
 #pragma once
 
+#include <brigadier/Result.hpp>
+#include <brigadier/reader/CharClasses.hpp>
+#include <concepts>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace brigadier {
 /**
  * @brief A reader, used to read a string and parse it
  *
  * @see StringReader for an implementation
+ * @see StringViewReader for a non-owning implementation
  *
  * it is used by the parser to read the command string
  */
@@ -16,11 +23,13 @@ public:
     virtual ~Reader() = default;
 
     virtual std::string getString() const = 0;
+    virtual std::string_view getStringView() const = 0;
     virtual size_t getRemainingLength() const = 0;
     virtual size_t getTotalLength() const = 0;
     virtual size_t getCursor() const = 0;
     virtual std::string getRead() const = 0;
     virtual std::string getRemaining() const = 0;
+    virtual std::string_view getRemainingView() const { return getStringView().substr(getCursor()); }
     virtual void setCursor(size_t cursor) = 0;
 
     virtual bool canRead(size_t length) const = 0;
@@ -30,20 +39,11 @@ public:
 
     virtual void skip() = 0;
 
-    virtual bool isQuotedStringStart(char c) const { return c == '"' || c == '\''; }
+    virtual bool isQuotedStringStart(char c) const { return _classes->is(c, CharClasses::Quote); }
+    virtual bool isAllowedInUnquotedString(char c) const { return _classes->is(c, CharClasses::Unquoted); }
+    virtual bool isSpace(char c) const { return _classes->is(c, CharClasses::Space); }
 
-    virtual bool isAllowedInUnquotedString(char c) const
-    {
-        return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' || c == '-' || c == '.' || c == '+';
-    }
-
-    virtual bool isSpace(char c) const { return std::isspace(c); }
-
-    virtual void skipWhitespace()
-    {
-        while (this->canRead() && this->isSpace(this->peek()))
-            this->skip();
-    }
+    virtual void skipWhitespace();
 
     virtual bool readBool();
     virtual int readInt();
@@ -54,6 +54,75 @@ public:
     virtual std::string readUnquotedString();
     virtual std::string readQuotedString();
     virtual std::string readStringUntil(char terminator);
+
+    /**
+     * @brief Zero-copy variants of the string readers
+     *
+     * The returned views point into the string returned by `getStringView()`,
+     * they are only valid as long as the underlying input is alive.
+     * Escape sequences are kept as-is, like in the owning variants.
+     */
+    virtual std::string_view readStringView();
+    virtual std::string_view readUnquotedView();
+    virtual std::string_view readQuotedView();
+    virtual std::string_view readStringUntilView(char terminator);
+
+    /**
+     * @brief Non-throwing variants of the readers
+     *
+     * On error the cursor is left where the read started and the returned `ParseError`
+     * holds the reason and the position. The throwing readers are wrappers around these.
+     */
+    virtual Result<bool> tryReadBool();
+    virtual Result<int> tryReadInt();
+    virtual Result<long> tryReadLong();
+    virtual Result<double> tryReadDouble();
+    virtual Result<float> tryReadFloat();
+    virtual Result<std::string_view> tryReadStringView();
+    virtual Result<std::string_view> tryReadUnquotedView();
+    virtual Result<std::string_view> tryReadQuotedView();
+    virtual Result<std::string_view> tryReadStringUntilView(char terminator);
+
+    /**
+     * @brief Set where parsers allocate the values they build, e.g. `PmrStringParser`
+     *
+     * @param resource nullptr for the default resource
+     */
+    void setMemoryResource(std::pmr::memory_resource *resource) { _resource = resource; }
+    std::pmr::memory_resource *getMemoryResource() const { return _resource ? _resource : std::pmr::get_default_resource(); }
+
+    /**
+     * @brief Set which characters are whitespace, allowed in unquoted strings and quotes
+     *
+     * @param classes nullptr for `standardCharClasses`, it must outlive the reader
+     */
+    void setCharClasses(const CharClasses *classes) { _classes = classes ? classes : &standardCharClasses; }
+    const CharClasses &getCharClasses() const { return *_classes; }
+
+private:
+    std::pmr::memory_resource *_resource = nullptr;
+    const CharClasses *_classes = &standardCharClasses;
+};
+
+/**
+ * @brief Check if type R is a brigadier reader
+ *
+ * Parsers and command nodes are templated on the reader type: when R declares its primitives `final`
+ * (e.g. `StringViewReader`) the calls are resolved statically and the scanning loops are inlined.
+ * `Reader` itself satisfies this concept and is used as the type-erased fallback.
+ *
+ * @tparam R The class to check
+ */
+template<typename R>
+concept is_reader = std::is_base_of_v<Reader, R> && requires(R &reader, const R &constReader, size_t cursor) {
+    // clang-format off
+    { constReader.getStringView() } -> std::same_as<std::string_view>;
+    { constReader.getCursor() } -> std::same_as<size_t>;
+    { constReader.canRead() } -> std::same_as<bool>;
+    { constReader.peek() } -> std::same_as<char>;
+    { reader.setCursor(cursor) };
+    { reader.skip() };
+    // clang-format on
 };
 
 } // namespace brigadier
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <brigadier/Result.hpp>
+#include <brigadier/exceptions.hpp>
+#include <brigadier/reader/NumberScanner.hpp>
+#include <brigadier/reader/Reader.hpp>
+#include <brigadier/reader/ScanKernels.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace brigadier::_util {
+/**
+ * @brief Scanning routines shared by every reader
+ *
+ * They are templated on the reader type so that a reader whose primitives are `final`
+ * (e.g. `StringViewReader`) gets them fully inlined, while `Reader` itself uses them
+ * through virtual calls.
+ *
+ * None of them throw: errors are returned and the cursor is left where the read started.
+ */
+/**
+ * @brief Readers whose character predicates are their `CharClasses`, scanned with the `ScanKernels`
+ */
+template<typename R>
+concept scans_char_classes = is_reader<R> && requires { requires R::scansCharClasses; };
+
+/**
+ * @brief Get the end of the run of characters of a class starting at from
+ */
+inline size_t spanClass(std::string_view input, size_t from, const CharClasses &classes, CharClasses::Class cls)
+{
+    // Most tokens are short: the first bytes are checked inline, the kernels only take over long runs
+    auto inlineEnd = std::min(input.size(), from + 16);
+    for (; from < inlineEnd; ++from) {
+        if (!classes.is(input[from], cls))
+            return from;
+    }
+    if (from == input.size())
+        return from;
+    return from + scanKernels().spanClass(input.data() + from, input.size() - from, classes, cls);
+}
+
+/**
+ * @brief Find the first terminator at or after from which is not escaped by a backslash
+ *
+ * @return size_t The size of the input if there is none, more if the input ends with a backslash
+ */
+inline size_t findUnescaped(std::string_view input, size_t from, char terminator)
+{
+    auto inlineEnd = std::min(input.size(), from + 16);
+    while (from < inlineEnd) {
+        if (input[from] == '\\')
+            from += 2;
+        else if (input[from] == terminator)
+            return from;
+        else
+            ++from;
+    }
+    if (from >= input.size())
+        return from;
+    return from + scanKernels().findUnescaped(input.data() + from, input.size() - from, terminator);
+}
+
+template<is_reader R>
+inline void skipWhitespace(R &reader)
+{
+    if constexpr (scans_char_classes<R>) {
+        reader.setCursor(spanClass(reader.getStringView(), reader.getCursor(), reader.getCharClasses(), CharClasses::Space));
+    } else {
+        while (reader.canRead() && reader.isSpace(reader.peek()))
+            reader.skip();
+    }
+}
+
+template<is_reader R>
+inline Result<std::string_view> tryReadUnquotedView(R &reader)
+{
+    auto start = reader.getCursor();
+
+    if constexpr (scans_char_classes<R>) {
+        reader.setCursor(spanClass(reader.getStringView(), start, reader.getCharClasses(), CharClasses::Unquoted));
+    } else {
+        while (reader.canRead() && reader.isAllowedInUnquotedString(reader.peek()))
+            reader.skip();
+    }
+    auto view = reader.getStringView().substr(start, reader.getCursor() - start);
+    reader.skipWhitespace();
+    if (view.empty()) {
+        reader.setCursor(start);
+        return ParseError {ErrorCode::ExpectedString, start};
+    }
+    return view;
+}
+
+/**
+ * @brief Read up to an unescaped terminator, a backslash escapes the character following it
+ */
+template<is_reader R>
+inline Result<std::string_view> tryReadStringUntilView(R &reader, char terminator)
+{
+    auto start = reader.getCursor();
+
+    if constexpr (scans_char_classes<R>) {
+        auto input = reader.getStringView();
+        auto at = findUnescaped(input, start, terminator);
+        if (at > input.size()) {
+            reader.setCursor(start);
+            return ParseError {ErrorCode::ExpectedEscapeSequence, start};
+        }
+        reader.setCursor(at);
+    } else {
+        while (reader.canRead()) {
+            auto c = reader.peek();
+            if (c == '\\') {
+                reader.skip();
+                if (!reader.canRead()) {
+                    reader.setCursor(start);
+                    return ParseError {ErrorCode::ExpectedEscapeSequence, start};
+                }
+            } else if (c == terminator) {
+                break;
+            }
+            reader.skip();
+        }
+    }
+    auto end = reader.getCursor();
+    if (start == end) {
+        reader.setCursor(start);
+        return ParseError {ErrorCode::ExpectedString, start};
+    }
+    if (!reader.canRead() || reader.peek() != terminator) {
+        reader.setCursor(start);
+        return ParseError {ErrorCode::ExpectedEndOfQuote, start};
+    }
+    reader.skip();
+    reader.skipWhitespace();
+    return reader.getStringView().substr(start, end - start);
+}
+
+template<is_reader R>
+inline Result<std::string_view> tryReadQuotedView(R &reader)
+{
+    if (!reader.canRead())
+        return std::string_view {};
+    auto start = reader.getCursor();
+    auto next = reader.peek();
+    if (!reader.isQuotedStringStart(next))
+        return ParseError {ErrorCode::ExpectedQuote, start};
+    reader.skip();
+    auto result = reader.tryReadStringUntilView(next);
+    if (!result)
+        reader.setCursor(start);
+    return result;
+}
+
+template<is_reader R>
+inline Result<std::string_view> tryReadStringView(R &reader)
+{
+    if (reader.canRead() && reader.isQuotedStringStart(reader.peek()))
+        return reader.tryReadQuotedView();
+    return reader.tryReadUnquotedView();
+}
+
+template<is_reader R>
+inline Result<bool> tryReadBool(R &reader)
+{
+    auto start = reader.getCursor();
+    auto str = reader.tryReadUnquotedView();
+
+    if (!str)
+        return str.error();
+    if (*str == "false" || *str == "0")
+        return false;
+    else if (*str == "true" || *str == "1")
+        return true;
+    reader.setCursor(start);
+    return ParseError {ErrorCode::InvalidBool, start};
+}
+
+template<typename T>
+constexpr ErrorCode expectedNumberError()
+{
+    if constexpr (std::is_same_v<T, int>)
+        return ErrorCode::ExpectedInt;
+    else if constexpr (std::is_same_v<T, long>)
+        return ErrorCode::ExpectedLong;
+    else if constexpr (std::is_same_v<T, float>)
+        return ErrorCode::ExpectedFloat;
+    else if constexpr (std::is_same_v<T, double>)
+        return ErrorCode::ExpectedDouble;
+    else
+        return ErrorCode::ExpectedNumber;
+}
+
+/**
+ * @brief Scan a number from the reader
+ *
+ * The number must span the whole unquoted token, on success the cursor is moved past it
+ * and the following whitespaces, on error the cursor is left untouched.
+ */
+template<typename T, is_reader R>
+inline NumberScan<T> scanNumber(R &reader, NumberFormat format)
+{
+    auto input = reader.getRemainingView();
+    auto result = brigadier::scanNumber<T>(input, format);
+
+    if (result && result.length < input.size() && reader.isAllowedInUnquotedString(input[result.length]))
+        result.error = NumberError::TrailingGarbage;
+    if (result) {
+        reader.setCursor(reader.getCursor() + result.length);
+        reader.skipWhitespace();
+    }
+    return result;
+}
+
+template<typename T, is_reader R>
+inline Result<T> tryReadNumber(R &reader, NumberFormat format)
+{
+    auto start = reader.getCursor();
+    auto result = scanNumber<T>(reader, format);
+
+    if (result.error == NumberError::Overflow)
+        return ParseError {ErrorCode::NumberOutOfRange, start};
+    if (!result)
+        return ParseError {expectedNumberError<T>(), start};
+    return result.value;
+}
+
+} // namespace brigadier::_util
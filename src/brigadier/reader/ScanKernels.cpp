@@ -0,0 +1,240 @@
+#include <brigadier/reader/ScanKernels.hpp>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BRIGADIER_X86 1
+#include <immintrin.h>
+#endif
+
+using brigadier::CharClasses;
+
+namespace {
+size_t spanClassScalar(const char *data, size_t size, const CharClasses &classes, CharClasses::Class cls)
+{
+    size_t i = 0;
+    while (i < size && classes.is(data[i], cls))
+        ++i;
+    return i;
+}
+
+size_t findUnescapedScalar(const char *data, size_t size, char terminator)
+{
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] == '\\') {
+            if (++i == size)
+                return size + 1;
+        } else if (data[i] == terminator) {
+            return i;
+        }
+    }
+    return size;
+}
+
+/**
+ * Walk the backslashes and terminators of a block in order, the character after a backslash is escaped
+ *
+ * @param escaped Whether the first character of the block is escaped, then whether the first of the next one is
+ * @return int The position of the first unescaped terminator, -1 if there is none
+ */
+int findUnescapedInBlock(uint32_t terminators, uint32_t backslashes, int width, bool &escaped)
+{
+    if (escaped) {
+        terminators &= ~1u;
+        backslashes &= ~1u;
+        escaped = false;
+    }
+    auto events = terminators | backslashes;
+    while (events != 0) {
+        auto at = std::countr_zero(events);
+        events &= events - 1;
+        if (((backslashes >> at) & 1) == 0)
+            return at;
+        if (at + 1 == width) {
+            escaped = true;
+            break;
+        }
+        events &= ~(1u << (at + 1));
+    }
+    return -1;
+}
+
+size_t findUnescapedTail(const char *data, size_t i, size_t size, char terminator, bool escaped)
+{
+    if (escaped) {
+        if (i == size)
+            return size + 1;
+        ++i;
+    }
+    return i + findUnescapedScalar(data + i, size - i, terminator);
+}
+
+#ifdef BRIGADIER_X86
+/*
+ * A byte is in a range [first, first + width] when (byte - first) wraps to at most width:
+ * min_epu8(offset, width) == offset. Bytes in none of the ranges set a bit of the returned mask.
+ */
+
+__attribute__((target("sse2"))) size_t spanClassSse2(const char *data, size_t size, const CharClasses &classes, CharClasses::Class cls)
+{
+    auto &ranges = classes.getRanges(cls);
+    if (!ranges.isVectorizable())
+        return spanClassScalar(data, size, classes, cls);
+    __m128i firsts[CharClasses::maxRanges];
+    __m128i widths[CharClasses::maxRanges];
+    for (size_t r = 0; r < ranges.count; ++r) {
+        firsts[r] = _mm_set1_epi8(static_cast<char>(ranges.first[r]));
+        widths[r] = _mm_set1_epi8(static_cast<char>(ranges.width[r]));
+    }
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto in = _mm_setzero_si128();
+        for (size_t r = 0; r < ranges.count; ++r) {
+            auto offset = _mm_sub_epi8(bytes, firsts[r]);
+            in = _mm_or_si128(in, _mm_cmpeq_epi8(_mm_min_epu8(offset, widths[r]), offset));
+        }
+        auto outside = ~static_cast<uint32_t>(_mm_movemask_epi8(in)) & 0xFFFFu;
+        if (outside != 0)
+            return i + std::countr_zero(outside);
+    }
+    return i + spanClassScalar(data + i, size - i, classes, cls);
+}
+
+__attribute__((target("sse2"))) size_t findUnescapedSse2(const char *data, size_t size, char terminator)
+{
+    auto terminators = _mm_set1_epi8(terminator);
+    auto backslashes = _mm_set1_epi8('\\');
+    bool escaped = false;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto found = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, terminators)));
+        auto escapes = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslashes)));
+        if ((found | escapes) == 0 && !escaped)
+            continue;
+        if (auto at = findUnescapedInBlock(found, escapes, 16, escaped); at >= 0)
+            return i + at;
+    }
+    return findUnescapedTail(data, i, size, terminator, escaped);
+}
+
+/*
+ * Two nibble lookups per 32 bytes, whatever the number of ranges of the class
+ */
+__attribute__((target("avx2"))) size_t spanClassAvx2(const char *data, size_t size, const CharClasses &classes, CharClasses::Class cls)
+{
+    auto &nibbles = classes.getNibbles(cls);
+    if (!nibbles.exact)
+        return spanClassSse2(data, size, classes, cls);
+    auto low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(nibbles.low.data())));
+    auto high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(nibbles.high.data())));
+    auto mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto lows = _mm256_shuffle_epi8(low, _mm256_and_si256(bytes, mask));
+        auto highs = _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+        auto outside = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lows, highs), _mm256_setzero_si256())));
+        if (outside != 0)
+            return i + std::countr_zero(outside);
+    }
+    return i + spanClassSse2(data + i, size - i, classes, cls);
+}
+
+__attribute__((target("avx2"))) size_t findUnescapedAvx2(const char *data, size_t size, char terminator)
+{
+    auto terminators = _mm256_set1_epi8(terminator);
+    auto backslashes = _mm256_set1_epi8('\\');
+    bool escaped = false;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto found = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, terminators)));
+        auto escapes = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, backslashes)));
+        if ((found | escapes) == 0 && !escaped)
+            continue;
+        if (auto at = findUnescapedInBlock(found, escapes, 32, escaped); at >= 0)
+            return i + at;
+    }
+    return findUnescapedTail(data, i, size, terminator, escaped);
+}
+#endif
+
+constexpr brigadier::_util::ScanKernels scalarKernels {spanClassScalar, findUnescapedScalar};
+#ifdef BRIGADIER_X86
+constexpr brigadier::_util::ScanKernels sse2Kernels {spanClassSse2, findUnescapedSse2};
+constexpr brigadier::_util::ScanKernels avx2Kernels {spanClassAvx2, findUnescapedAvx2};
+#endif
+
+bool isSupported(brigadier::ScanLevel level)
+{
+    switch (level) {
+    case brigadier::ScanLevel::Scalar:
+        return true;
+#ifdef BRIGADIER_X86
+    case brigadier::ScanLevel::Sse2:
+        return __builtin_cpu_supports("sse2");
+    case brigadier::ScanLevel::Avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+const brigadier::_util::ScanKernels *kernelsOf(brigadier::ScanLevel level)
+{
+    switch (level) {
+#ifdef BRIGADIER_X86
+    case brigadier::ScanLevel::Sse2:
+        return &sse2Kernels;
+    case brigadier::ScanLevel::Avx2:
+        return &avx2Kernels;
+#endif
+    default:
+        return &scalarKernels;
+    }
+}
+
+brigadier::ScanLevel bestLevel()
+{
+    for (auto level : {brigadier::ScanLevel::Avx2, brigadier::ScanLevel::Sse2}) {
+        if (isSupported(level))
+            return level;
+    }
+    return brigadier::ScanLevel::Scalar;
+}
+
+struct Current {
+    std::atomic<const brigadier::_util::ScanKernels *> kernels;
+    std::atomic<brigadier::ScanLevel> level;
+
+    Current()
+    {
+        auto best = bestLevel();
+        kernels.store(kernelsOf(best), std::memory_order_relaxed);
+        level.store(best, std::memory_order_relaxed);
+    }
+};
+
+Current &current()
+{
+    static Current current;
+    return current;
+}
+} // namespace
+
+brigadier::ScanLevel brigadier::getScanLevel() { return current().level.load(std::memory_order_relaxed); }
+
+bool brigadier::setScanLevel(ScanLevel level)
+{
+    if (!isSupported(level))
+        return false;
+    current().kernels.store(kernelsOf(level), std::memory_order_relaxed);
+    current().level.store(level, std::memory_order_relaxed);
+    return true;
+}
+
+const brigadier::_util::ScanKernels &brigadier::_util::scanKernels() { return *current().kernels.load(std::memory_order_relaxed); }
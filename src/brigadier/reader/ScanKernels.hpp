@@ -0,0 +1,52 @@
+#pragma once
+
+#include <brigadier/reader/CharClasses.hpp>
+#include <cstddef>
+
+namespace brigadier {
+/**
+ * @brief The instruction set the readers scan long runs of characters with
+ */
+enum class ScanLevel {
+    Scalar, ///< One table lookup per byte
+    Sse2,   ///< 16 bytes at a time
+    Avx2,   ///< 32 bytes at a time
+};
+
+/**
+ * @brief Get the level in use, the best one the CPU supports unless `setScanLevel` changed it
+ */
+ScanLevel getScanLevel();
+
+/**
+ * @brief Force a level, e.g. to compare them
+ *
+ * @param level
+ * @return bool false, and nothing changes, if the CPU does not support it
+ */
+bool setScanLevel(ScanLevel level);
+
+namespace _util {
+/**
+ * @brief The vectorized scanners of the current `ScanLevel`
+ *
+ * Each returns an offset in [0, size]: size when the searched byte is not found.
+ * They are out of line, readers first check a few bytes inline and only call them on long runs.
+ */
+struct ScanKernels {
+    /**
+     * @brief Find the first byte that is not in the class
+     */
+    size_t (*spanClass)(const char *data, size_t size, const CharClasses &classes, CharClasses::Class cls);
+
+    /**
+     * @brief Find the first terminator which is not escaped by a backslash, e.g. a closing quote
+     *
+     * @return size_t size + 1 if the data ends with an unfinished escape sequence
+     */
+    size_t (*findUnescaped)(const char *data, size_t size, char terminator);
+};
+
+const ScanKernels &scanKernels();
+} // namespace _util
+} // namespace brigadier
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <brigadier/reader/Reader.hpp>
+#include <brigadier/reader/Scan.hpp>
+#include <brigadier/reader/Tokens.hpp>
+#include <stdexcept>
+#include <string_view>
+
+namespace brigadier {
+/**
+ * @brief A reader over a string it does not own
+ *
+ * The input must outlive the reader, as well as every view read from it.
+ * Use `StringReader` if the reader needs to own its input.
+ *
+ * Every member is `final`, so parsers and command nodes templated on this reader
+ * resolve all calls statically and get the scanning loops inlined.
+ * Its character predicates are those of its `CharClasses`, which lets it scan long runs with vector instructions.
+ * Given `Tokens`, its string reads look the token at the cursor up instead of scanning it.
+ */
+class StringViewReader : public Reader {
+public:
+    static constexpr bool scansCharClasses = true;
+
+    StringViewReader(std::string_view str, size_t cursor = 0):
+        _string(str),
+        _cursor(cursor)
+    {
+    }
+    ~StringViewReader() = default;
+
+    std::string getString() const final { return std::string(_string); }
+    std::string_view getStringView() const final { return _string; }
+    size_t getRemainingLength() const final { return _string.size() - _cursor; }
+    size_t getTotalLength() const final { return _string.size(); }
+    size_t getCursor() const final { return _cursor; }
+    std::string getRead() const final { return std::string(_string.substr(0, _cursor)); }
+    std::string getRemaining() const final { return std::string(_string.substr(_cursor)); }
+    std::string_view getRemainingView() const final { return _string.substr(_cursor); }
+    void setCursor(size_t cursor) final { _cursor = cursor; }
+
+    bool canRead(size_t length) const final { return _cursor + length < _string.size(); }
+    bool canRead() const final { return _cursor < _string.size(); }
+    char peek() const final { return _cursor < _string.size() ? _string[_cursor] : '\0'; }
+    char peek(size_t offset) const final
+    {
+        if (_cursor + offset >= _string.size())
+            throw std::out_of_range("Cannot peek past end of string");
+        return _string[_cursor + offset];
+    }
+    void skip() final { _cursor++; }
+
+    bool isQuotedStringStart(char c) const final { return Reader::isQuotedStringStart(c); }
+    bool isAllowedInUnquotedString(char c) const final { return Reader::isAllowedInUnquotedString(c); }
+    bool isSpace(char c) const final { return Reader::isSpace(c); }
+    void skipWhitespace() final { _util::skipWhitespace(*this); }
+
+    bool readBool() final { return valueOrThrow(tryReadBool(), *this); }
+    int readInt() final { return valueOrThrow(tryReadInt(), *this); }
+    long readLong() final { return valueOrThrow(tryReadLong(), *this); }
+    double readDouble() final { return valueOrThrow(tryReadDouble(), *this); }
+    float readFloat() final { return valueOrThrow(tryReadFloat(), *this); }
+    std::string readString() final { return std::string(readStringView()); }
+    std::string readUnquotedString() final { return std::string(readUnquotedView()); }
+    std::string readQuotedString() final { return std::string(readQuotedView()); }
+    std::string readStringUntil(char terminator) final { return std::string(readStringUntilView(terminator)); }
+    std::string_view readStringView() final { return valueOrThrow(tryReadStringView(), *this); }
+    std::string_view readUnquotedView() final { return valueOrThrow(tryReadUnquotedView(), *this); }
+    std::string_view readQuotedView() final { return valueOrThrow(tryReadQuotedView(), *this); }
+    std::string_view readStringUntilView(char terminator) final { return valueOrThrow(tryReadStringUntilView(terminator), *this); }
+
+    Result<bool> tryReadBool() final { return _util::tryReadBool(*this); }
+    Result<int> tryReadInt() final { return _util::tryReadNumber<int>(*this, NumberFormat::Decimal); }
+    Result<long> tryReadLong() final { return _util::tryReadNumber<long>(*this, NumberFormat::Decimal); }
+    Result<double> tryReadDouble() final { return _util::tryReadNumber<double>(*this, NumberFormat::Decimal); }
+    Result<float> tryReadFloat() final { return _util::tryReadNumber<float>(*this, NumberFormat::Decimal); }
+    Result<std::string_view> tryReadStringView() final
+    {
+        if (auto token = tokenAtCursor())
+            return readToken(*token);
+        return _util::tryReadStringView(*this);
+    }
+    Result<std::string_view> tryReadUnquotedView() final
+    {
+        if (auto token = tokenAtCursor(); token && !token->quoted)
+            return readToken(*token);
+        return _util::tryReadUnquotedView(*this);
+    }
+    Result<std::string_view> tryReadQuotedView() final
+    {
+        if (auto token = tokenAtCursor(); token && token->quoted)
+            return readToken(*token);
+        return _util::tryReadQuotedView(*this);
+    }
+    Result<std::string_view> tryReadStringUntilView(char terminator) final { return _util::tryReadStringUntilView(*this, terminator); }
+
+    /**
+     * @brief Read strings from the tokens of the input instead of scanning them
+     *
+     * The input is lexed into them on the first string read, with the `CharClasses` of the reader at that time.
+     *
+     * @param tokens nullptr to scan again, it must outlive the reader
+     */
+    void setTokens(Tokens *tokens)
+    {
+        _tokens = tokens;
+        _nextToken = 0;
+        if (tokens)
+            tokens->clear();
+    }
+    const Tokens *getTokens() const { return _tokens; }
+
+private:
+    const Tokens::Token *tokenAtCursor()
+    {
+        if (_tokens == nullptr)
+            return nullptr;
+        if (!_tokens->isLexed())
+            _tokens->lex(_string, getCharClasses());
+        auto index = _tokens->find(_cursor, _nextToken);
+        if (index == _tokens->size())
+            return nullptr;
+        _nextToken = index + 1;
+        return &(*_tokens)[index];
+    }
+
+    std::string_view readToken(const Tokens::Token &token)
+    {
+        _cursor = token.next;
+        return token.view(_string);
+    }
+
+private:
+    std::string_view _string;
+    size_t _cursor;
+    Tokens *_tokens = nullptr;
+    size_t _nextToken = 0; ///< Following the last token read, where the next read most likely starts
+};
+
+} // namespace brigadier
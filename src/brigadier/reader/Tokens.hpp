@@ -0,0 +1,127 @@
+#pragma once
+
+#include <brigadier/reader/CharClasses.hpp>
+#include <brigadier/reader/Scan.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace brigadier {
+/**
+ * @brief The string tokens of an input, split in one pass
+ *
+ * A token is what a string read starting at its offset returns: a run of unquoted characters, or a
+ * valid quoted string. Once a reader is given the tokens of its input, its string reads are
+ * lookups by index: reading a token again after moving the cursor back, e.g. when a child node fails and
+ * its parent parses its own arguments, does not scan its characters again.
+ *
+ * Offsets where no token starts (invalid quoted strings, characters of neither class) are read
+ * by scanning, so errors and their positions are the same with and without tokens.
+ * The raw characters are still there for parsers which need them, e.g. `GreedyStringParser`.
+ *
+ * @code
+ * brigadier::Tokens tokens;
+ * brigadier::StringViewReader reader(input);
+ * reader.setTokens(&tokens); // lexed on the first string read
+ * registry.parse(player, reader);
+ * @endcode
+ */
+class Tokens {
+public:
+    struct Token {
+        uint32_t offset; ///< At the opening quote of a quoted token
+        uint32_t length; ///< Quotes included
+        uint32_t next;   ///< Where the cursor goes once the token is read, past the whitespace following it
+        bool quoted;
+
+        /**
+         * @brief The value of the token in the input, without its quotes
+         */
+        std::string_view view(std::string_view input) const { return quoted ? input.substr(offset + 1, length - 2) : input.substr(offset, length); }
+    };
+
+    /**
+     * @brief The number of tokens kept, inline: reads past the last of them scan as usual
+     */
+    static constexpr size_t capacity = 32;
+
+    Tokens() = default;
+    Tokens(const Tokens &) = delete;
+    Tokens &operator=(const Tokens &) = delete;
+
+    /**
+     * @brief Split the input into the tokens a reader with these classes would read, replacing the previous ones
+     *
+     * Lexing stops after `capacity` tokens. Inputs too long for 32-bit offsets get no tokens.
+     *
+     * @param input
+     * @param classes
+     */
+    void lex(std::string_view input, const CharClasses &classes)
+    {
+        _size = 0;
+        _lexed = true;
+        if (input.size() > std::numeric_limits<uint32_t>::max())
+            return;
+        auto at = _util::spanClass(input, 0, classes, CharClasses::Space);
+        while (at < input.size() && _size < capacity) {
+            auto c = input[at];
+            auto quoted = classes.is(c, CharClasses::Quote);
+            size_t end = at;
+            if (quoted) {
+                // Same checks as tryReadStringUntilView: terminated, not empty and no dangling escape
+                auto close = _util::findUnescaped(input, at + 1, c);
+                if (close < input.size() && close != at + 1)
+                    end = close + 1;
+            } else if (classes.is(c, CharClasses::Unquoted)) {
+                end = _util::spanClass(input, at, classes, CharClasses::Unquoted);
+            }
+            if (end == at) {
+                // No read succeeds here, the next token may start at the next character
+                at = _util::spanClass(input, at + 1, classes, CharClasses::Space);
+                continue;
+            }
+            auto next = _util::spanClass(input, end, classes, CharClasses::Space);
+            _tokens[_size++] = {static_cast<uint32_t>(at), static_cast<uint32_t>(end - at), static_cast<uint32_t>(next), quoted};
+            at = next;
+        }
+    }
+
+    /**
+     * @brief Forget the tokens, the next reader using them lexes its input again
+     */
+    void clear()
+    {
+        _size = 0;
+        _lexed = false;
+    }
+
+    bool isLexed() const { return _lexed; }
+    size_t size() const { return _size; }
+    const Token &operator[](size_t index) const { return _tokens[index]; }
+    const Token *begin() const { return _tokens.data(); }
+    const Token *end() const { return _tokens.data() + _size; }
+
+    /**
+     * @brief Get the index of the token starting at offset
+     *
+     * @param offset
+     * @param hint Checked first, e.g. the token following the last one read
+     * @return size_t size() if no token starts there
+     */
+    size_t find(size_t offset, size_t hint = 0) const
+    {
+        if (hint < _size && _tokens[hint].offset == offset)
+            return hint;
+        auto it = std::lower_bound(begin(), end(), offset, [](const Token &token, size_t offset) { return token.offset < offset; });
+        return it != end() && it->offset == offset ? static_cast<size_t>(it - begin()) : _size;
+    }
+
+private:
+    std::array<Token, capacity> _tokens; // Only the first _size are set
+    size_t _size = 0;
+    bool _lexed = false;
+};
+} // namespace brigadier
@@ -0,0 +1,348 @@
+#include "brigadier/CommandNodeBuilder.hpp"
+#include "brigadier/ParallelDispatcher.hpp"
+#include "brigadier/parser/Number.hpp"
+#include "brigadier/parser/String.hpp"
+#include <atomic>
+#include <brigadier/Registry.hpp>
+#include <brigadier/TypeHolder.hpp>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Player {
+    std::vector<int> received;
+    std::thread::id thread;
+};
+
+static void addGive(brigadier::Registry &registry, std::atomic<long> &total)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::TypeHolder;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "Give items")
+        .alias("g")
+        .expectArg<NumberParser<int>>("count")
+        .execute([&total](TypeHolder &ctx, int count) {
+            total += count;
+            if (ctx.is<Player>()) {
+                ctx.getAs<Player>().received.push_back(count);
+                ctx.getAs<Player>().thread = std::this_thread::get_id();
+            }
+        })
+        .suggestionBuilder([](TypeHolder &) {
+            return std::vector<std::string> {"1", "64"};
+        })
+        .add(CommandNodeBuilder("all", "Give to everyone")
+            .expectArg<NumberParser<int>>("count")
+            .execute([&total](TypeHolder &, int count) {
+                total += count;
+            })
+        )
+    );
+    // clang-format on
+}
+
+TEST(parallelDispatcher, concurrentReadOnlyDispatch)
+{
+    brigadier::Registry registry;
+    std::atomic<long> total = 0;
+    addGive(registry, total);
+    registry.setCacheCapacity(8);
+
+    constexpr int threads = 8;
+    constexpr int iterations = 2000;
+    std::atomic<int> failures = 0;
+    std::vector<std::thread> pool;
+
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            brigadier::TypeHolder holder;
+            for (int i = 0; i < iterations; ++i) {
+                auto input = (i % 2 ? "g " : "give all ") + std::to_string(i % 16);
+                if (!registry.isValidInput(input) || !registry.tryParse(input))
+                    ++failures;
+                auto results = registry.parseOnly(nullptr, input);
+                if (!results)
+                    ++failures;
+                if (registry.tryParse("give nope"))
+                    ++failures;
+                brigadier::StringViewReader reader("give 1");
+                if (registry.listSuggestions(holder, reader).size() != 2)
+                    ++failures;
+            }
+        });
+    }
+    for (auto &thread : pool)
+        thread.join();
+
+    long expected = 0;
+    for (int i = 0; i < iterations; ++i)
+        expected += i % 16;
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(total, expected * threads);
+}
+
+TEST(parallelDispatcher, preservesOrderPerSource)
+{
+    brigadier::Registry registry;
+    std::atomic<long> total = 0;
+    addGive(registry, total);
+
+    brigadier::ParallelDispatcher dispatcher(registry, 4);
+    std::vector<Player> players(16);
+    std::vector<brigadier::Command> commands;
+    std::vector<std::string> inputs;
+
+    inputs.reserve(16 * 50 + 1);
+    for (int i = 0; i < 50; ++i) {
+        for (auto &player : players)
+            commands.push_back({player, inputs.emplace_back("give " + std::to_string(i))});
+    }
+    commands.push_back({players[0], "give lots"});
+
+    auto results = dispatcher.dispatch(commands);
+
+    ASSERT_EQ(results.size(), commands.size());
+    EXPECT_EQ(results.back().error().code, brigadier::ErrorCode::ExpectedInt);
+    for (size_t i = 0; i + 1 < results.size(); ++i)
+        EXPECT_TRUE(results[i]);
+    for (auto &player : players) {
+        ASSERT_EQ(player.received.size(), 50);
+        for (int i = 0; i < 50; ++i)
+            EXPECT_EQ(player.received[i], i);
+    }
+    EXPECT_EQ(total, 16 * (49 * 50 / 2));
+}
+
+TEST(parallelDispatcher, executesOnCaller)
+{
+    brigadier::Registry registry;
+    std::atomic<long> total = 0;
+    addGive(registry, total);
+
+    brigadier::ParallelDispatcher dispatcher(registry, 2);
+    std::vector<Player> players(4);
+    std::vector<brigadier::Command> commands;
+
+    for (auto &player : players)
+        commands.push_back({player, "give 3"});
+
+    auto results = dispatcher.dispatch(commands, brigadier::ParallelDispatcher::Execution::Caller);
+
+    for (auto &result : results)
+        EXPECT_TRUE(result);
+    for (auto &player : players)
+        EXPECT_EQ(player.thread, std::this_thread::get_id());
+    EXPECT_EQ(total, 12);
+}
+
+TEST(parallelDispatcher, hotReloadWhileDispatching)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::TypeHolder;
+
+    brigadier::Registry registry;
+    std::atomic<long> total = 0;
+    std::atomic<long> temporary = 0;
+    addGive(registry, total);
+    registry.setCacheCapacity(8);
+
+    auto makeTemporary = [&] {
+        return CommandNodeBuilder("tmp", "Comes and goes").expectArg<NumberParser<int>>("count").execute([&temporary](TypeHolder &, int count) { temporary += count; }).build();
+    };
+    // Registering from a callback must not wait for its own dispatch
+    registry.add(CommandNodeBuilder("register", "Register tmp").execute([&](TypeHolder &) { registry.add(makeTemporary()); }).build());
+
+    constexpr int threads = 4;
+    constexpr int iterations = 2000;
+    std::atomic<int> failures = 0;
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> pool;
+
+    auto kept = registry.parseOnly(nullptr, "give 2");
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&] {
+            for (int i = 0; i < iterations; ++i) {
+                if (!registry.tryParse("give 1"))
+                    ++failures;
+                // Either the previous tree or the new one, never a dangling one
+                auto result = registry.tryParse("tmp 1");
+                if (!result && result.error().code != brigadier::ErrorCode::UnknownCommand)
+                    ++failures;
+            }
+        });
+    }
+    std::thread writer([&] {
+        while (!stop) {
+            registry.add(makeTemporary());
+            registry.remove("tmp");
+            registry.parse("register");
+            registry.remove("tmp");
+        }
+    });
+    for (auto &thread : pool)
+        thread.join();
+    stop = true;
+    writer.join();
+
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(total, threads * iterations);
+
+    registry.reload({});
+    EXPECT_FALSE(registry.isValidInput("give 1"));
+    registry.execute(kept);
+    EXPECT_EQ(total, threads * iterations + 2);
+}
+
+TEST(parallelDispatcher, registerFromCallbackWhileAnotherWriterWaits)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::TypeHolder;
+
+    brigadier::Registry registry;
+    std::atomic<bool> entered = false;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("register", "").execute([&](TypeHolder &) {
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        registry.add(CommandNodeBuilder("late", "").execute([](TypeHolder &) {}).build());
+    }).build());
+    // clang-format on
+
+    // A writer adds while the callback is in its read section, then the callback adds too: neither waits for the other
+    std::thread dispatching([&] { registry.parse("register"); });
+    while (!entered)
+        std::this_thread::yield();
+    registry.add(CommandNodeBuilder("early", "").execute([](TypeHolder &) {}).build());
+    dispatching.join();
+
+    EXPECT_TRUE(registry.isValidInput("early"));
+    EXPECT_TRUE(registry.isValidInput("late"));
+}
+
+TEST(parallelDispatcher, registerIntoEachOtherFromCallbacks)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::TypeHolder;
+
+    brigadier::Registry first;
+    brigadier::Registry second;
+    std::atomic<int> entered = 0;
+
+    // Each callback adds to the registry the other one is dispatched from, while both are dispatching
+    auto crossing = [&](brigadier::Registry &other, std::string_view name) {
+        return CommandNodeBuilder("cross", "").execute([&entered, &other, name](TypeHolder &) {
+            ++entered;
+            while (entered < 2)
+                std::this_thread::yield();
+            other.add(CommandNodeBuilder(name, "").execute([](TypeHolder &) {}).build());
+        }).build();
+    };
+    first.add(crossing(second, "fromFirst"));
+    second.add(crossing(first, "fromSecond"));
+
+    std::thread dispatching([&] { first.parse("cross"); });
+    second.parse("cross");
+    dispatching.join();
+
+    EXPECT_TRUE(first.isValidInput("fromSecond"));
+    EXPECT_TRUE(second.isValidInput("fromFirst"));
+}
+
+TEST(parallelDispatcher, previousVersionsFreedByTheLastDispatch)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::TypeHolder;
+
+    brigadier::Registry registry;
+    auto removed = CommandNodeBuilder("removed", "").execute([](TypeHolder &) {}).build();
+    registry.add(removed);
+
+    registry.add(CommandNodeBuilder("remove", "").execute([&](TypeHolder &) {
+        registry.remove("removed");
+        // The dispatch still uses the version holding it
+        EXPECT_GT(removed.use_count(), 1);
+    }).build());
+    registry.parse("remove");
+
+    EXPECT_FALSE(registry.isValidInput("removed"));
+    EXPECT_EQ(removed.use_count(), 1);
+}
+
+TEST(parallelDispatcher, forkRunsSourcesOnWorkers)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::TypeHolder;
+
+    brigadier::Registry registry;
+    std::atomic<long> total = 0;
+    std::atomic<int> failed = 0;
+    addGive(registry, total);
+    brigadier::ParallelDispatcher dispatcher(registry, 4);
+    std::vector<Player> players(64);
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("execute", "")
+        .add(CommandNodeBuilder("as", "")
+            .expectArg<NumberParser<int>>("count")
+            .fork(registry, "execute", [&players](TypeHolder &, int count) {
+                std::vector<TypeHolder> sources;
+                for (int i = 0; i < count; ++i)
+                    sources.emplace_back(players[i]);
+                return sources;
+            }, &dispatcher, 8)
+        )
+        .add(CommandNodeBuilder("run", "").redirect(registry))
+    );
+    registry.add(CommandNodeBuilder("fail", "")
+        .expectArg<NumberParser<int>>("every")
+        .execute([&players, &failed](TypeHolder &source, int every) {
+            auto index = &source.getAs<Player>() - players.data();
+            if (index % every == every - 1) {
+                ++failed;
+                throw std::runtime_error(std::to_string(index));
+            }
+        })
+    );
+    // clang-format on
+
+    registry.parse("execute as 64 run give 2");
+    EXPECT_EQ(total, 128);
+    for (auto &player : players)
+        EXPECT_EQ(player.received, std::vector<int> {2});
+
+    // Below the threshold the sources run in order on the caller
+    registry.parse("execute as 4 run give 1");
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(players[i].thread, std::this_thread::get_id());
+
+    // In parallel every source runs, and the failure of the first source is rethrown
+    try {
+        registry.parse("execute as 64 run fail 10");
+        FAIL();
+    } catch (const std::runtime_error &error) {
+        EXPECT_STREQ(error.what(), "9");
+    }
+    EXPECT_EQ(failed, 6);
+    // In order the first failure stops the others
+    failed = 0;
+    EXPECT_THROW(registry.parse("execute as 4 run fail 2"), std::runtime_error);
+    EXPECT_EQ(failed, 1);
+
+    // Forks of commands dispatched on the workers share them with the batch
+    total = 0;
+    std::vector<brigadier::Command> commands;
+    for (int i = 0; i < 8; ++i)
+        commands.push_back({players[i], "execute as 64 run give all 1"});
+    for (auto &result : dispatcher.dispatch(commands))
+        EXPECT_TRUE(result);
+    EXPECT_EQ(total, 8 * 64);
+}
@@ -3,6 +3,7 @@
 #include "brigadier/parser/Number.hpp"
 #include "brigadier/parser/String.hpp"
 #include "brigadier/reader/StringReader.hpp"
+#include "brigadier/reader/StringViewReader.hpp"
 #include <gtest/gtest.h>
 
 using brigadier::StringReader;
@@ -203,3 +204,76 @@ TEST(parser, emptyGreedyString)
 
     EXPECT_THROW(parser::parse(reader), brigadier::CommandSyntaxException);
 }
+
+//* string views
+TEST(parser, validStringView)
+{
+    using parser = brigadier::StringViewParser;
+
+    std::string input = "test 'mama papa'";
+    auto reader = brigadier::StringViewReader(input);
+
+    EXPECT_EQ("test", parser::parse(reader));
+    auto quoted = parser::parse(reader);
+    EXPECT_EQ("mama papa", quoted);
+    EXPECT_EQ(input.data() + 6, quoted.data());
+}
+
+TEST(parser, validGreedyStringView)
+{
+    using parser = brigadier::GreedyStringViewParser;
+
+    std::string input = "test mama";
+    auto reader = brigadier::StringViewReader(input);
+
+    EXPECT_EQ("test mama", parser::parse(reader));
+    EXPECT_FALSE(reader.canRead());
+    EXPECT_THROW(parser::parse(reader), brigadier::CommandSyntaxException);
+}
+
+//* reader types
+TEST(parser, parsersAcceptAnyReader)
+{
+    static_assert(brigadier::is_parser<brigadier::NumberParser<int>, brigadier::StringViewReader>);
+    static_assert(brigadier::is_parser<brigadier::StringParser, brigadier::StringReader>);
+    static_assert(brigadier::is_parser<brigadier::BoolParser>);
+
+    std::string input = "42 true";
+    brigadier::StringViewReader view(input);
+    brigadier::Reader &erased = view;
+
+    EXPECT_EQ(42, brigadier::NumberParser<int>::parse(view));
+    EXPECT_EQ(true, brigadier::BoolParser::parse(erased));
+}
+
+//* number formats
+TEST(parser, numberFormats)
+{
+    using brigadier::NumberFormat;
+    using hexParser = brigadier::NumberParser<int, NumberFormat::Hex>;
+    using scientificParser = brigadier::NumberParser<double, NumberFormat::Exponent | NumberFormat::Underscores>;
+
+    auto reader = StringReader("0x2A 1_000e-3");
+
+    EXPECT_EQ(42, hexParser::parse(reader));
+    EXPECT_EQ(1.0, scientificParser::parse(reader));
+
+    auto decimal = StringReader("0x2A");
+    EXPECT_THROW(brigadier::NumberParser<int>::parse(decimal), brigadier::CommandSyntaxException);
+    EXPECT_EQ(decimal.getCursor(), 0);
+}
+
+TEST(parser, tryParse)
+{
+    using brigadier::ErrorCode;
+
+    auto reader = StringReader("42 nope");
+
+    EXPECT_EQ(42, *brigadier::NumberParser<int>::tryParse(reader));
+    auto error = brigadier::NumberParser<int>::tryParse(reader);
+    ASSERT_FALSE(error);
+    EXPECT_EQ(error.error().code, ErrorCode::ExpectedInt);
+    EXPECT_EQ(error.error().cursor, 3);
+    EXPECT_EQ("nope", *brigadier::StringParser::tryParse(reader));
+    EXPECT_EQ(brigadier::GreedyStringParser::tryParse(reader).error().code, ErrorCode::ExpectedString);
+}
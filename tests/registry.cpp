@@ -1,8 +1,16 @@
 #include "brigadier/CommandNodeBuilder.hpp"
 #include "brigadier/exceptions.hpp"
 #include "brigadier/parser/Number.hpp"
+#include "brigadier/parser/String.hpp"
 #include <brigadier/Registry.hpp>
+#include <brigadier/StaticRegistry.hpp>
+#include <brigadier/SuggestionSession.hpp>
+#include <brigadier/Tracing.hpp>
 #include <brigadier/TypeHolder.hpp>
+#include <array>
+#include <deque>
+#include <sstream>
+#include <thread>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -142,3 +150,968 @@ TEST(registryParsing, simpleCommandParseWithArgsAndSubcommand)
     EXPECT_NO_THROW(registry.parse(obj, testCommand));
     EXPECT_NO_THROW(registry.parse(obj, testSubCommand));
 }
+
+TEST(registryParsing, argumentsAreParsedInOrder)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringParser;
+    using brigadier::StringViewReader;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+
+    Context obj;
+
+    registry.add(CommandNodeBuilder("give", "Give items")
+                     .expectArg<StringParser>("player")
+                     .expectArg<NumberParser<int>>("count")
+                     .execute([](TypeHolder &ctx, std::string player, int count) {
+                         EXPECT_EQ(player, "steve");
+                         EXPECT_EQ(count, 64);
+                         ctx.getAs<Context>().call();
+                     }));
+
+    EXPECT_CALL(obj, call()).Times(2);
+
+    std::string input = "give steve 64";
+    auto viewCommand = StringViewReader(input);
+    auto ownedCommand = brigadier::StringReader(input);
+
+    EXPECT_TRUE(registry.isValidInput(viewCommand));
+    EXPECT_NO_THROW(registry.parse(obj, viewCommand));
+    EXPECT_NO_THROW(registry.parse(obj, ownedCommand));
+}
+
+TEST(registryParsing, tryParseReportsErrors)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringViewReader;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+
+    Context obj;
+
+    registry.add(CommandNodeBuilder("test", "A test command").expectArg<NumberParser<int>>("int", "An integer argument").execute([](TypeHolder &ctx, int arg) {
+        ctx.getAs<Context>().call();
+    }));
+
+    EXPECT_CALL(obj, call()).Times(1);
+
+    auto unknown = StringViewReader("  nope 1");
+    auto result = registry.tryParse(obj, unknown);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, ErrorCode::UnknownCommand);
+    EXPECT_EQ(result.error().cursor, 2);
+    EXPECT_EQ(unknown.getCursor(), 0);
+
+    auto invalid = StringViewReader("test abc");
+    result = registry.tryParse(obj, invalid);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, ErrorCode::ExpectedInt);
+    EXPECT_EQ(result.error().cursor, 5);
+    EXPECT_EQ(invalid.getCursor(), 0);
+
+    EXPECT_EQ(registry.tryValidate("test 1 2").error().code, ErrorCode::ExpectedEndOfCommand);
+    EXPECT_TRUE(registry.tryValidate("test 1"));
+
+    auto valid = StringViewReader("test 1");
+    EXPECT_TRUE(registry.tryParse(obj, valid));
+
+    // The exception outlives a temporary input
+    try {
+        registry.parse(std::string("test abc"));
+        FAIL() << "parse should have thrown";
+    } catch (const brigadier::CommandSyntaxException &e) {
+        EXPECT_STREQ(e.what(), "Expected int at position 5 whilst reading test abc");
+    }
+}
+
+TEST(registryParsing, dispatchByNameAndAlias)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::Registry;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::deque<std::string> names;
+    std::vector<int> calls;
+
+    for (int i = 0; i < 500; ++i) {
+        registry.add(CommandNodeBuilder(names.emplace_back("command" + std::to_string(i)), "").alias("c" + std::to_string(i)).execute([&calls, i](TypeHolder &) {
+            calls.push_back(i);
+        }));
+    }
+    // The first node registered under a name wins
+    registry.add(CommandNodeBuilder("command7", "").execute([&calls](TypeHolder &) {
+        calls.push_back(-1);
+    }));
+    registry.add(CommandNodeBuilder("teleport", "").alias("tp").add(CommandNodeBuilder("home", "").alias("h").execute([&calls](TypeHolder &) {
+        calls.push_back(1000);
+    })));
+
+    registry.parse("command42");
+    registry.parse("c499");
+    registry.parse("command7");
+    registry.parse("tp h");
+    registry.parse("teleport home");
+
+    EXPECT_EQ(calls, (std::vector<int> {42, 499, 7, 1000, 1000}));
+    EXPECT_FALSE(registry.isValidInput("command500"));
+    EXPECT_FALSE(registry.isValidInput("tp x"));
+}
+
+TEST(compiledRegistry, dispatchesLikeTheRegistry)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::CompiledRegistry;
+    using brigadier::ErrorCode;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::vector<int> calls;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("test", "A test command")
+        .alias("t")
+        .expectArg<NumberParser<int>>("int", "An integer argument")
+        .execute([&calls](TypeHolder &, int arg) {
+            calls.push_back(arg);
+        })
+        .suggestionBuilder([](TypeHolder &) {
+            return std::vector<std::string> {"1", "2"};
+        })
+        .add(CommandNodeBuilder("subcommand", "A subcommand")
+            .alias("sub")
+            .expectArg<NumberParser<int>>("int", "An integer argument")
+            .execute([&calls](TypeHolder &, int arg) {
+                calls.push_back(-arg);
+            }
+        )
+    ));
+    // clang-format on
+
+    auto compiled = registry.freeze();
+    registry.add(CommandNodeBuilder("late", "Added after freezing").execute([](TypeHolder &) {}));
+
+    EXPECT_EQ(compiled.size(), 3);
+    auto test = compiled.find(CompiledRegistry::root, "t");
+    ASSERT_NE(test, CompiledRegistry::npos);
+    EXPECT_EQ(compiled.getName(test), "test");
+    EXPECT_EQ(compiled.find(test, "sub"), compiled.find(test, "subcommand"));
+    EXPECT_EQ(compiled.find(CompiledRegistry::root, "late"), CompiledRegistry::npos);
+
+    compiled.parse("test 1");
+    compiled.parse("  t sub 2");
+    EXPECT_EQ(calls, (std::vector<int> {1, -2}));
+
+    EXPECT_TRUE(compiled.isValidInput("test subcommand 3"));
+    EXPECT_EQ(compiled.tryValidate("test 1 2").error().code, ErrorCode::ExpectedEndOfCommand);
+    EXPECT_EQ(compiled.tryParse("late").error().code, ErrorCode::UnknownCommand);
+    auto invalid = compiled.tryParse("test sub nope");
+    ASSERT_FALSE(invalid);
+    EXPECT_EQ(invalid.error(), (brigadier::ParseError {ErrorCode::ExpectedInt, 9}));
+    EXPECT_THROW(compiled.parse("test nope"), brigadier::CommandSyntaxException);
+
+    TypeHolder holder;
+    auto reader = brigadier::StringViewReader("test 1");
+    EXPECT_EQ(compiled.listSuggestions(holder, reader), (std::vector<std::string> {"1", "2"}));
+}
+
+TEST(staticRegistry, dispatchesLikeTheRegistry)
+{
+    using brigadier::Alias;
+    using brigadier::Args;
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::Executes;
+    using brigadier::Literal;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringViewParser;
+    using brigadier::TypeHolder;
+
+    using Calls = std::vector<std::string>;
+    brigadier::StaticRegistry<
+        Literal<"test", Alias<"t">, Args<NumberParser<int>>, Executes<[](TypeHolder &source, int arg) { source.getAs<Calls>().push_back(std::to_string(arg)); }>,
+            Literal<"subcommand", Alias<"sub">, Args<NumberParser<int>>, Executes<[](TypeHolder &source, int arg) { source.getAs<Calls>().push_back(std::to_string(-arg)); }>>,
+            Literal<"group", Literal<"say", Args<StringViewParser>, Executes<[](TypeHolder &source, std::string_view text) { source.getAs<Calls>().emplace_back(text); }>>>>,
+        Literal<"Tell", Args<StringViewParser>, Executes<[](TypeHolder &source, std::string_view text) { source.getAs<Calls>().emplace_back(text); }>>>
+        compiled;
+
+    Registry registry;
+    // clang-format off
+    registry.add(CommandNodeBuilder("test", "")
+        .alias("t")
+        .expectArg<NumberParser<int>>("int")
+        .execute([](TypeHolder &source, int arg) {
+            source.getAs<Calls>().push_back(std::to_string(arg));
+        })
+        .add(CommandNodeBuilder("subcommand", "")
+            .alias("sub")
+            .expectArg<NumberParser<int>>("int")
+            .execute([](TypeHolder &source, int arg) {
+                source.getAs<Calls>().push_back(std::to_string(-arg));
+            }))
+        .add(CommandNodeBuilder("group", "")
+            .add(CommandNodeBuilder("say", "")
+                .expectArg<StringViewParser>("text")
+                .execute([](TypeHolder &source, std::string_view text) {
+                    source.getAs<Calls>().emplace_back(text);
+                }))));
+    registry.add(CommandNodeBuilder("Tell", "")
+        .expectArg<StringViewParser>("text")
+        .execute([](TypeHolder &source, std::string_view text) {
+            source.getAs<Calls>().emplace_back(text);
+        }));
+    // clang-format on
+
+    EXPECT_TRUE(compiled.contains("t"));
+    EXPECT_FALSE(compiled.contains("subcommand"));
+
+    for (std::string_view input : {"test 1", "  t sub 2", "test group say hi", "Tell \"a b\"", "test", "test group", "test sub nope", "nope", "", "test 1 2", "tell x", "test group say"}) {
+        Calls expected, actual;
+        auto expectedResult = registry.tryParse(TypeHolder(expected), input);
+        auto actualResult = compiled.tryParse(TypeHolder(actual), input);
+        EXPECT_EQ(actualResult.hasValue(), expectedResult.hasValue()) << input;
+        if (!expectedResult && !actualResult) {
+            EXPECT_EQ(actualResult.error(), expectedResult.error()) << input;
+        }
+        EXPECT_EQ(actual, expected) << input;
+        auto validation = compiled.tryValidate(input);
+        EXPECT_EQ(validation.hasValue(), registry.isValidInput(input)) << input;
+        if (!validation) {
+            EXPECT_EQ(validation.error(), registry.tryValidate(input).error()) << input;
+        }
+    }
+    EXPECT_THROW(compiled.parse("test nope"), brigadier::CommandSyntaxException);
+
+    // Usable through the same interface as a Registry
+    const brigadier::ICommandNode &node = compiled;
+    Calls calls;
+    TypeHolder holder(calls);
+    auto reader = brigadier::StringViewReader("t sub 3");
+    EXPECT_TRUE(node.tryParse(holder, reader));
+    EXPECT_EQ(calls, (Calls {"-3"}));
+
+    for (std::string_view input : {"", "t", "test ", "test s", "test group s", "T"}) {
+        auto expectedReader = brigadier::StringViewReader(input);
+        auto actualReader = brigadier::StringViewReader(input);
+        EXPECT_EQ(node.listSuggestions(holder, actualReader), registry.listSuggestions(holder, expectedReader)) << input;
+    }
+}
+
+TEST(registryParsing, parseOnlyThenExecute)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringParser;
+    using brigadier::StringViewReader;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    Context obj;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "Give items")
+        .add(CommandNodeBuilder("item", "Give an item")
+            .expectArg<StringParser>("player")
+            .expectArg<NumberParser<int>>("count")
+            .execute([](TypeHolder &ctx, std::string player, int count) {
+                EXPECT_EQ(player, "steve");
+                EXPECT_EQ(count, 64);
+                ctx.getAs<Context>().call();
+            })
+        ));
+    // clang-format on
+
+    EXPECT_CALL(obj, call()).Times(2);
+
+    std::string input = " give item steve 64 ";
+    auto reader = StringViewReader(input);
+    auto results = registry.parseOnly(obj, reader);
+
+    ASSERT_TRUE(results);
+    EXPECT_EQ(reader.getCursor(), 0);
+    ASSERT_EQ(results.getPath().size(), 2);
+    EXPECT_EQ(results.getPath()[0]->getName(), "give");
+    EXPECT_EQ(results.getNode()->getName(), "item");
+    EXPECT_EQ(results.getRange(), input);
+    registry.execute(results);
+    registry.execute(results);
+
+    auto trailing = registry.parseOnly(obj, "give item steve 64 extra");
+    EXPECT_FALSE(trailing);
+    EXPECT_EQ(trailing.getError(), (brigadier::ParseError {ErrorCode::ExpectedEndOfCommand, 19}));
+    EXPECT_THROW(registry.execute(trailing), brigadier::CommandSyntaxException);
+
+    auto invalid = registry.parseOnly(obj, "give item steve lots");
+    EXPECT_EQ(invalid.getError(), (brigadier::ParseError {ErrorCode::ExpectedInt, 16}));
+    EXPECT_EQ(invalid.getPath().size(), 2);
+    EXPECT_EQ(registry.parseOnly(obj, "take").getError().code, ErrorCode::UnknownCommand);
+}
+
+TEST(registryParsing, parseCache)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringViewParser;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::vector<std::string> calls;
+
+    registry.setCacheCapacity(2);
+    registry.add(CommandNodeBuilder("say", "").expectArg<StringViewParser>("word").execute([&calls](TypeHolder &, std::string_view word) {
+        calls.emplace_back(word);
+    }));
+
+    {
+        // The cached arguments must not point into the caller's input
+        std::string input = "say hello";
+        registry.parse(input);
+    }
+    registry.parse("say hello");
+    registry.parse("say world");
+    registry.parse("say again");
+    registry.parse("say hello");
+    registry.parse("say again trailing");
+    EXPECT_EQ(registry.tryParse("say \"open").error(), (brigadier::ParseError {ErrorCode::ExpectedEndOfQuote, 5}));
+    EXPECT_EQ(calls, (std::vector<std::string> {"hello", "hello", "world", "again", "hello", "again"}));
+
+    // Invalid inputs and trailing input are cached too, the reader stops where the trailing input starts
+    brigadier::StringViewReader trailing("say again trailing");
+    TypeHolder holder;
+    EXPECT_TRUE(registry.tryParse(holder, trailing));
+    EXPECT_EQ(trailing.getCursor(), 10);
+    EXPECT_EQ(calls.back(), "again");
+    EXPECT_EQ(registry.tryParse("say \"open").error(), (brigadier::ParseError {ErrorCode::ExpectedEndOfQuote, 5}));
+
+    auto stats = registry.getCacheStats();
+    EXPECT_EQ(stats.hits, 3);
+    EXPECT_EQ(stats.misses, 6);
+    EXPECT_EQ(stats.size, 2);
+    EXPECT_EQ(stats.capacity, 2);
+
+    registry.add(CommandNodeBuilder("other", "").execute([](TypeHolder &) {}));
+    EXPECT_EQ(registry.getCacheStats().size, 0);
+}
+
+TEST(registryParsing, parseCacheEvictedFromCallback)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::Registry;
+    using brigadier::StringViewParser;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::vector<std::string> calls;
+
+    registry.setCacheCapacity(1);
+    registry.add(CommandNodeBuilder("other", "").execute([](TypeHolder &) {}));
+    registry.add(CommandNodeBuilder("say", "").expectArg<StringViewParser>("word").execute([&](TypeHolder &, std::string_view word) {
+        // Evicts the entry being executed, its input must outlive the eviction
+        registry.parse("other");
+        calls.emplace_back(word);
+    }));
+
+    registry.parse("say hello");
+    registry.parse("say hello");
+    EXPECT_EQ(calls, (std::vector<std::string> {"hello", "hello"}));
+}
+
+TEST(registryParsing, parseBatch)
+{
+    using brigadier::Command;
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::vector<int> calls;
+
+    registry.add(CommandNodeBuilder("a", "").expectArg<NumberParser<int>>("n").execute([&calls](TypeHolder &, int n) {
+        calls.push_back(n);
+    }));
+    registry.add(CommandNodeBuilder("b", "").add(CommandNodeBuilder("sub", "").expectArg<NumberParser<int>>("n").execute([&calls](TypeHolder &ctx, int n) {
+        ctx.getAs<Context>().call();
+        calls.push_back(-n);
+    })));
+
+    Context obj;
+    EXPECT_CALL(obj, call()).Times(2);
+
+    std::vector<Command> commands;
+    commands.push_back({obj, "b sub 1"});
+    commands.push_back({obj, "a 2"});
+    commands.push_back({obj, "nope 3"});
+    commands.push_back({obj, "b sub 4"});
+    commands.push_back({obj, "a x"});
+    commands.push_back({obj, "a 5"});
+
+    auto results = registry.parseBatch(commands);
+
+    ASSERT_EQ(results.size(), commands.size());
+    EXPECT_TRUE(results[0]);
+    EXPECT_TRUE(results[1]);
+    EXPECT_EQ(results[2].error(), (brigadier::ParseError {ErrorCode::UnknownCommand, 0}));
+    EXPECT_TRUE(results[3]);
+    EXPECT_EQ(results[4].error(), (brigadier::ParseError {ErrorCode::ExpectedInt, 2}));
+    EXPECT_TRUE(results[5]);
+    EXPECT_EQ(calls, (std::vector<int> {-1, 2, -4, 5}));
+}
+
+TEST(registryParsing, pmrArgumentsUseTheArena)
+{
+    using brigadier::Arena;
+    using brigadier::CommandNodeBuilder;
+    using brigadier::GreedyPmrStringParser;
+    using brigadier::PmrStringParser;
+    using brigadier::Registry;
+    using brigadier::StringViewReader;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::vector<std::string> calls;
+    std::vector<std::pmr::memory_resource *> resources;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("msg", "")
+        .expectArg<PmrStringParser>("to")
+        .expectArg<GreedyPmrStringParser>("message")
+        .execute([&](TypeHolder &, std::pmr::string to, std::pmr::string message) {
+            calls.emplace_back(to);
+            calls.emplace_back(message);
+            resources.push_back(to.get_allocator().resource());
+            resources.push_back(message.get_allocator().resource());
+        })
+    );
+    // clang-format on
+
+    registry.parse("msg someone_with_a_long_name a message too long for the small string buffer");
+    ASSERT_EQ(resources.size(), 2);
+    EXPECT_NE(dynamic_cast<Arena *>(resources[0]), nullptr);
+    EXPECT_EQ(resources[0], resources[1]);
+
+    Arena arena(64);
+    StringViewReader reader("msg me hi");
+    reader.setMemoryResource(&arena);
+    TypeHolder holder;
+    registry.parse(holder, reader);
+    EXPECT_EQ(resources.back(), &arena);
+    arena.reset();
+
+    EXPECT_TRUE(registry.isValidInput("msg me \"quoted\" words"));
+    EXPECT_FALSE(registry.isValidInput("msg \"unterminated"));
+    EXPECT_EQ(calls, (std::vector<std::string> {"someone_with_a_long_name", "a message too long for the small string buffer", "me", "hi"}));
+}
+
+TEST(registryParsing, streamedSuggestions)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringViewReader;
+    using brigadier::SuggestionsBuilder;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    int offered = 0;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "")
+        .expectArg<NumberParser<int>>("count")
+        .execute([](TypeHolder &, int) {})
+        .suggestionBuilder([&offered](TypeHolder &, SuggestionsBuilder &builder) {
+            static constexpr std::string_view items[] = {"apple", "diamond", "dirt", "diorite", "dispenser", "door"};
+            for (auto item : items) {
+                ++offered;
+                if (!builder.suggest(item))
+                    return;
+            }
+        })
+    );
+    registry.add(CommandNodeBuilder("say", "")
+        .execute([](TypeHolder &) {})
+        .suggestionBuilder([](TypeHolder &) {
+            return std::vector<std::string> {"hello", "help", "world"};
+        })
+    );
+    // clang-format on
+
+    TypeHolder holder;
+    std::vector<std::string> suggestions;
+    {
+        SuggestionsBuilder builder(suggestions, 2, "di");
+        StringViewReader reader("give 1");
+        registry.listSuggestions(holder, reader, builder);
+        EXPECT_TRUE(builder.isFull());
+    }
+    EXPECT_EQ(suggestions, (std::vector<std::string> {"diamond", "dirt"}));
+    EXPECT_EQ(offered, 3);
+
+    size_t total = 0;
+    auto count = [&total](std::string_view candidate) { total += candidate.size(); };
+    SuggestionsBuilder counter(count, SuggestionsBuilder::unlimited, "he");
+    StringViewReader reader("say");
+    registry.listSuggestions(holder, reader, counter);
+    EXPECT_EQ(counter.getCount(), 2);
+    EXPECT_EQ(total, 9);
+
+    StringViewReader all("give 1");
+    EXPECT_EQ(registry.listSuggestions(holder, all).size(), 6);
+}
+
+TEST(registryParsing, completeLiterals)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::Registry;
+    using brigadier::StringViewReader;
+    using brigadier::SuggestionsBuilder;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    auto noop = [](TypeHolder &) {};
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "").alias("Gift").execute(noop)
+        .add(CommandNodeBuilder("all", "").execute(noop))
+        .add(CommandNodeBuilder("allies", "").execute(noop))
+        .add(CommandNodeBuilder("me", "").execute(noop))
+    );
+    registry.add(CommandNodeBuilder("gamemode", "").execute(noop));
+    registry.add(CommandNodeBuilder("tp", "").execute(noop));
+    registry.add(CommandNodeBuilder("hidden", "").withPermission([](const TypeHolder &) { return false; }).execute(noop));
+    // clang-format on
+
+    auto complete = [&](std::string_view input, bool caseInsensitive = false) {
+        TypeHolder holder;
+        std::vector<std::string> suggestions;
+        SuggestionsBuilder builder(suggestions);
+        builder.setCaseInsensitive(caseInsensitive);
+        StringViewReader reader(input);
+        registry.listSuggestions(holder, reader, builder);
+        return suggestions;
+    };
+
+    EXPECT_EQ(complete("g"), (std::vector<std::string> {"gamemode", "give"}));
+    EXPECT_EQ(complete("g", true), (std::vector<std::string> {"gamemode", "Gift", "give"}));
+    EXPECT_EQ(complete("gi"), (std::vector<std::string> {"give"}));
+    EXPECT_EQ(complete("h"), (std::vector<std::string> {}));
+    EXPECT_EQ(complete("give al"), (std::vector<std::string> {"all", "allies"}));
+    EXPECT_EQ(complete("give "), (std::vector<std::string> {"all", "allies", "me"}));
+    EXPECT_EQ(complete("give al x"), (std::vector<std::string> {}));
+
+    // Keys added in bulk, out of order, then one at a time are merged into the same order
+    registry.addAll(std::vector<std::shared_ptr<brigadier::ICommandNode>> {
+        CommandNodeBuilder("gc", "").execute(noop).build(),
+        CommandNodeBuilder("ga", "").alias("GB").execute(noop).build(),
+    });
+    registry.add(CommandNodeBuilder("gb", "").execute(noop));
+    EXPECT_EQ(complete("g"), (std::vector<std::string> {"ga", "gamemode", "gb", "gc", "give"}));
+    EXPECT_EQ(complete("g", true), (std::vector<std::string> {"ga", "gamemode", "GB", "gb", "gc", "Gift", "give"}));
+
+    TypeHolder holder;
+    StringViewReader reader("give a");
+    EXPECT_EQ(registry.freeze().listSuggestions(holder, reader), (std::vector<std::string> {"all", "allies"}));
+}
+
+TEST(registryParsing, incrementalSuggestions)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::GreedyStringParser;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringParser;
+    using brigadier::StringViewReader;
+    using brigadier::SuggestionSession;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    auto items = [](TypeHolder &) {
+        return std::vector<std::string> {"apple", "diamond", "dirt"};
+    };
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "")
+        .add(CommandNodeBuilder("to", "")
+            .expectArg<StringParser>("player")
+            .expectArg<NumberParser<int>>("count")
+            .expectArg<GreedyStringParser>("item")
+            .execute([](TypeHolder &, std::string, int, std::string) {})
+            .suggestionBuilder(items)
+        )
+        .add(CommandNodeBuilder("token", "").execute([](TypeHolder &) {}))
+    );
+    registry.add(CommandNodeBuilder("gamemode", "").execute([](TypeHolder &) {}));
+    // clang-format on
+
+    TypeHolder holder;
+    SuggestionSession session(registry);
+    auto expectSameAsRegistry = [&](std::string_view line) {
+        for (size_t i = 0; i <= line.size(); ++i) {
+            auto input = line.substr(0, i);
+            StringViewReader reader(input);
+            EXPECT_EQ(session.listSuggestions(holder, input), registry.listSuggestions(holder, reader)) << '"' << input << '"';
+        }
+    };
+
+    expectSameAsRegistry("give to steve 64 some long item name");
+    EXPECT_EQ(session.getResumedAt(), 17);
+    expectSameAsRegistry("give token");
+    expectSameAsRegistry("gamemode x");
+    expectSameAsRegistry("give to \"quoted name\" 3 x");
+    // Whitespace typed after a checkpoint is skipped like a full parse does
+    expectSameAsRegistry("give  to   steve    64     some item");
+    expectSameAsRegistry("gi    ");
+
+    // Editing the middle of the line resumes before the edit
+    EXPECT_EQ(session.listSuggestions(holder, "give to steve 64 a"), (std::vector<std::string> {"apple", "diamond", "dirt"}));
+    EXPECT_EQ(session.listSuggestions(holder, "give to steve x a"), (std::vector<std::string> {}));
+    EXPECT_EQ(session.getResumedAt(), 14);
+
+    // Modifying the registry starts over
+    registry.add(CommandNodeBuilder("gift", "").execute([](TypeHolder &) {}));
+    EXPECT_EQ(session.listSuggestions(holder, "gi"), (std::vector<std::string> {"gift", "give"}));
+    EXPECT_EQ(session.getResumedAt(), 0);
+}
+
+TEST(registryParsing, nodeMetrics)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringViewReader;
+    using brigadier::TypeHolder;
+
+    if constexpr (!brigadier::options::metrics)
+        GTEST_SKIP() << "Built without ENABLE_METRICS";
+
+    Registry registry;
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "")
+        .expectArg<NumberParser<int>>("count")
+        .execute([](TypeHolder &, int) {})
+        .add(CommandNodeBuilder("op", "")
+            .withPermission([](const TypeHolder &) { return false; })
+            .execute([](TypeHolder &) {})
+        )
+    );
+    // clang-format on
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&registry] {
+            for (int j = 0; j < 1000; ++j)
+                registry.parse("give 3");
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    EXPECT_FALSE(registry.tryParse("give three"));
+
+    TypeHolder holder;
+    StringViewReader reader("give o");
+    EXPECT_EQ(registry.listSuggestions(holder, reader), (std::vector<std::string> {}));
+
+    auto metrics = registry.getMetrics();
+    ASSERT_EQ(metrics.nodes.size(), 2);
+    auto give = metrics.find("give");
+    ASSERT_NE(give, nullptr);
+    EXPECT_EQ(give->dispatches, 4000);
+    EXPECT_EQ(give->failures, 1);
+    EXPECT_EQ(give->suggestions, 1);
+    EXPECT_EQ(give->parse.count(), 4001);
+    EXPECT_EQ(give->execute.count(), 4000);
+    EXPECT_GE(give->parse.quantile(0.99), give->parse.quantile(0.5));
+    auto op = metrics.find("give op");
+    ASSERT_NE(op, nullptr);
+    EXPECT_EQ(op->permissionDenials, 1);
+    EXPECT_EQ(op->dispatches, 0);
+
+    registry.resetMetrics();
+    EXPECT_EQ(registry.getMetrics().find("give")->dispatches, 0);
+}
+
+TEST(registryParsing, chromeTrace)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::Tracer;
+    using brigadier::TypeHolder;
+
+    if constexpr (!brigadier::options::tracing)
+        GTEST_SKIP() << "Built without ENABLE_TRACING";
+
+    Registry registry;
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "")
+        .add(CommandNodeBuilder("xp", "")
+            .expectArg<NumberParser<int>>("amount")
+            .execute([](TypeHolder &, int) {})
+        )
+    );
+    // clang-format on
+
+    Tracer::start();
+    registry.parse("give xp 30");
+    EXPECT_FALSE(registry.tryParse("give xp \"lots\""));
+    Tracer::stop();
+    registry.parse("give xp 1");
+
+    std::ostringstream trace;
+    Tracer::writeChromeTrace(trace);
+    auto json = trace.str();
+    EXPECT_THAT(json, testing::HasSubstr(R"({"name": "give xp 30", "cat": "registry", "ph": "X")"));
+    EXPECT_THAT(json, testing::HasSubstr(R"({"name": "xp", "cat": "node")"));
+    EXPECT_THAT(json, testing::HasSubstr(R"({"name": "NumberParser<int, (NumberFormat)0>", "cat": "parser")"));
+    EXPECT_THAT(json, testing::HasSubstr(R"({"name": "give xp \"lots\"", "cat": "registry")"));
+    EXPECT_THAT(json, testing::HasSubstr(R"("args": {"begin": 8, "end": 8, "outcome": "Expected int"})"));
+    EXPECT_THAT(json, testing::Not(testing::HasSubstr("give xp 1\"")));
+}
+
+namespace {
+/**
+ * Counts the copies of the values it parses
+ */
+struct CountedParser : public brigadier::Parser {
+    struct Counted {
+        static inline int copies = 0;
+
+        Counted() = default;
+        Counted(const Counted &) { ++copies; }
+        Counted(Counted &&) noexcept = default;
+        Counted &operator=(const Counted &) = delete;
+    };
+
+    using type = Counted;
+
+    template<brigadier::is_reader R>
+    static brigadier::Result<Counted> tryParse(R &reader)
+    {
+        auto token = reader.tryReadStringView();
+        if (!token)
+            return token.error();
+        return Counted {};
+    }
+};
+} // namespace
+
+TEST(registryParsing, moveOnlyCallbacks)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::Registry;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    int calls = 0;
+    auto counter = std::make_unique<int>(0);
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("count", "")
+        .expectArg<CountedParser>("value")
+        .execute([&calls, counter = std::move(counter)](TypeHolder &, CountedParser::Counted) {
+            ++*counter;
+            calls = *counter;
+        })
+    );
+    // clang-format on
+
+    registry.parse("count x");
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(CountedParser::Counted::copies, 0);
+
+    // Results may be executed again, each execution gets its own copy
+    auto results = registry.parseOnly(TypeHolder(), "count x");
+    registry.execute(results);
+    registry.execute(results);
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(CountedParser::Counted::copies, 2);
+
+    // The callback was moved into the first node, a second one would have none
+    CommandNodeBuilder builder("once", "");
+    builder.execute([](TypeHolder &) {}).build();
+    EXPECT_THROW(builder.build(), brigadier::BuilderException);
+    EXPECT_THROW(builder.expectArg<CountedParser>("value").build(), brigadier::BuilderException);
+
+    brigadier::Function<int(std::string), 8> large = [padding = std::array<char, 64> {}](std::string text) { return int(text.size() + padding.size()); };
+    auto moved = std::move(large);
+    EXPECT_FALSE(large);
+    EXPECT_EQ(moved("abc"), 67);
+    EXPECT_FALSE(brigadier::Function<void()>(static_cast<void (*)()>(nullptr)));
+}
+
+TEST(registryParsing, ambiguities)
+{
+    using brigadier::Ambiguity;
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::NumberParser;
+    using brigadier::Registry;
+    using brigadier::StringViewParser;
+    using brigadier::TypeHolder;
+
+    Registry registry;
+    std::vector<Ambiguity> reported;
+    registry.onAmbiguity([&reported](const Ambiguity &ambiguity) { reported.push_back(ambiguity); });
+    std::string called;
+
+    // clang-format off
+    auto give = CommandNodeBuilder("give", "")
+        .expectArg<StringViewParser>("player")
+        .execute([&called](TypeHolder &, std::string_view player) { called = "player " + std::string(player); })
+        .add(CommandNodeBuilder("all", "").execute([&called](TypeHolder &) { called = "all"; }))
+        .build();
+    auto time = CommandNodeBuilder("time", "")
+        .expectArg<NumberParser<int>>("ticks")
+        .execute([&called](TypeHolder &, int ticks) { called = "ticks " + std::to_string(ticks); })
+        .add(CommandNodeBuilder("set", "").execute([&called](TypeHolder &) { called = "set"; }))
+        .add(CommandNodeBuilder("10", "").execute([&called](TypeHolder &) { called = "ten"; }))
+        .build();
+    registry.add(give);
+    registry.add(time);
+    registry.add(CommandNodeBuilder("gift", "").alias("give").execute([](TypeHolder &) {}));
+    // clang-format on
+
+    // "set" is not a number, "10" is
+    ASSERT_EQ(reported.size(), 3);
+    EXPECT_EQ(reported[0].kind, Ambiguity::ShadowedArgument);
+    EXPECT_EQ(reported[0].path, "give");
+    EXPECT_EQ(reported[0].token, "all");
+    EXPECT_EQ(reported[0].hidden, give.get());
+    EXPECT_EQ(reported[1].kind, Ambiguity::ShadowedArgument);
+    EXPECT_EQ(reported[1].path, "time");
+    EXPECT_EQ(reported[1].token, "10");
+    EXPECT_EQ(reported[2].kind, Ambiguity::DuplicateLiteral);
+    EXPECT_EQ(reported[2].path, "");
+    EXPECT_EQ(reported[2].token, "give");
+    EXPECT_EQ(reported[2].taken, give.get());
+
+    // A level is checked before its subtrees
+    auto found = registry.findAmbiguities();
+    ASSERT_EQ(found.size(), 3);
+    EXPECT_EQ(found[0].kind, Ambiguity::DuplicateLiteral);
+    EXPECT_EQ(found[1].token, "all");
+    EXPECT_EQ(found[2].token, "10");
+
+    // Children are only looked up for tokens which can start one of them, quoted or not
+    registry.parse("give all");
+    EXPECT_EQ(called, "all");
+    registry.parse("give \"all\"");
+    EXPECT_EQ(called, "all");
+    registry.parse("give steve");
+    EXPECT_EQ(called, "player steve");
+    registry.parse("time 10");
+    EXPECT_EQ(called, "ten");
+    registry.parse("time 5");
+    EXPECT_EQ(called, "ticks 5");
+    EXPECT_EQ(registry.tryParse("time x").error(), (brigadier::ParseError {ErrorCode::ExpectedInt, 5}));
+    EXPECT_EQ(registry.tryValidate("time set 1").error(), (brigadier::ParseError {ErrorCode::ExpectedEndOfCommand, 9}));
+}
+
+namespace {
+/**
+ * Counts the integers it parses
+ */
+struct CountingIntParser : public brigadier::Parser {
+    static inline int parses = 0;
+
+    using type = int;
+
+    template<brigadier::is_reader R>
+    static brigadier::Result<int> tryParse(R &reader)
+    {
+        ++parses;
+        return brigadier::NumberParser<int>::tryParse(reader);
+    }
+};
+} // namespace
+
+TEST(registryParsing, redirectAndFork)
+{
+    using brigadier::CommandNodeBuilder;
+    using brigadier::ErrorCode;
+    using brigadier::Registry;
+    using brigadier::StringParser;
+    using brigadier::StringViewReader;
+    using brigadier::TypeHolder;
+    using testing::UnorderedElementsAre;
+
+    Registry registry;
+    std::vector<std::string> players {"alex", "steve", "notch"};
+    std::vector<std::string> log;
+
+    // clang-format off
+    registry.add(CommandNodeBuilder("give", "")
+        .expectArg<CountingIntParser>("count")
+        .execute([&log](TypeHolder &source, int count) {
+            log.push_back((source.is<std::string>() ? source.getAs<std::string>() : "console") + " " + std::to_string(count));
+        })
+    );
+    registry.add(CommandNodeBuilder("execute", "")
+        .add(CommandNodeBuilder("as", "")
+            .expectArg<StringParser>("targets")
+            .fork(registry, "execute", [&players](TypeHolder &, std::string targets) {
+                std::vector<TypeHolder> sources;
+                for (auto &player : players) {
+                    if (targets == "all" || targets == player)
+                        sources.emplace_back(player);
+                }
+                return sources;
+            })
+        )
+        .add(CommandNodeBuilder("run", "").redirect(registry))
+    );
+    // clang-format on
+
+    // The rest of the input is parsed once, then executed for each source
+    registry.parse("execute as all run give 3");
+    EXPECT_EQ(log, (std::vector<std::string> {"alex 3", "steve 3", "notch 3"}));
+    EXPECT_EQ(CountingIntParser::parses, 1);
+
+    // Forks chain through the redirect back to "execute"
+    log.clear();
+    registry.parse("execute as all as steve run give 1");
+    EXPECT_EQ(log, (std::vector<std::string> {"steve 1", "steve 1", "steve 1"}));
+    registry.parse("execute run give 2");
+    EXPECT_EQ(log.back(), "console 2");
+    EXPECT_EQ(CountingIntParser::parses, 3);
+
+    auto results = registry.parseOnly(TypeHolder(), "execute as notch run give 5");
+    ASSERT_TRUE(results);
+    log.clear();
+    registry.execute(results);
+    registry.execute(results);
+    EXPECT_EQ(log, (std::vector<std::string> {"notch 5", "notch 5"}));
+    EXPECT_EQ(CountingIntParser::parses, 4);
+
+    // Errors are reported where the rest of the input fails, validation follows the redirects too
+    EXPECT_TRUE(registry.tryParse("execute as nobody run give 1"));
+    EXPECT_EQ(registry.tryParse("execute as all run give x").error(), (brigadier::ParseError {ErrorCode::ExpectedInt, 24}));
+    EXPECT_TRUE(registry.tryValidate("execute as all run give 1"));
+    EXPECT_EQ(registry.tryValidate("execute as all run give 1 2").error(), (brigadier::ParseError {ErrorCode::ExpectedEndOfCommand, 26}));
+    EXPECT_FALSE(registry.parseOnly(TypeHolder(), "execute as all"));
+
+    // Suggestions continue at the target once the arguments are complete
+    TypeHolder holder;
+    StringViewReader afterRun("execute as all run ");
+    EXPECT_THAT(registry.listSuggestions(holder, afterRun), UnorderedElementsAre("execute", "give"));
+    StringViewReader afterTargets("execute as all ");
+    EXPECT_THAT(registry.listSuggestions(holder, afterTargets), UnorderedElementsAre("as", "run"));
+    brigadier::SuggestionSession session(registry);
+    EXPECT_EQ(session.listSuggestions(holder, "execute as all run gi"), (std::vector<std::string> {"give"}));
+}
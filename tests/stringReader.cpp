@@ -1,7 +1,9 @@
 #include <brigadier/exceptions.hpp>
 #include <brigadier/reader/StringReader.hpp>
+#include <brigadier/reader/StringViewReader.hpp>
 #include <gtest/gtest.h>
 #include <limits>
+#include <memory>
 #include <rapidcheck/Random.h>
 #include <rapidcheck/gen/Arbitrary.h>
 #include <rapidcheck/gtest.h>
@@ -306,3 +308,328 @@ TEST_F(ReaderDouble, testReadDouble)
     };
     rc::check(prop);
 }
+
+TEST(StringViewReader, readViewsPointIntoInput)
+{
+    std::string input = "hello 'quoted world' rest of input";
+    brigadier::StringViewReader reader(input);
+
+    auto unquoted = reader.readUnquotedView();
+    EXPECT_EQ(unquoted, "hello");
+    EXPECT_EQ(unquoted.data(), input.data());
+
+    auto quoted = reader.readQuotedView();
+    EXPECT_EQ(quoted, "quoted world");
+    EXPECT_EQ(quoted.data(), input.data() + 7);
+
+    EXPECT_EQ(reader.getRemainingView(), "rest of input");
+    EXPECT_EQ(reader.getRemainingView().data(), input.data() + 21);
+}
+
+TEST(StringViewReader, readStringView)
+{
+    std::string input = "\"a b\" c";
+    brigadier::StringViewReader reader(input);
+
+    EXPECT_EQ(reader.readStringView(), "a b");
+    EXPECT_EQ(reader.readStringView(), "c");
+    EXPECT_FALSE(reader.canRead());
+    EXPECT_THROW(reader.readStringView(), brigadier::CommandSyntaxException);
+}
+
+TEST(StringViewReader, sameBehaviourAsStringReader)
+{
+    std::string input = "Hello World";
+    brigadier::StringViewReader view(input);
+    brigadier::StringReader owning(input);
+
+    while (owning.canRead()) {
+        EXPECT_EQ(view.readString(), owning.readString());
+        EXPECT_EQ(view.getCursor(), owning.getCursor());
+    }
+    EXPECT_FALSE(view.canRead());
+}
+
+TEST(StringReader, copyOwnsItsInput)
+{
+    auto reader = std::make_unique<brigadier::StringReader>("Hello World");
+    reader->skip();
+    brigadier::StringReader copy(*reader);
+    reader.reset();
+
+    EXPECT_EQ(copy.getCursor(), 1);
+    EXPECT_EQ(copy.getRemainingView(), "ello World");
+}
+
+TEST(NumberScanner, errorCodes)
+{
+    using brigadier::NumberError;
+    using brigadier::scanNumber;
+
+    EXPECT_EQ(scanNumber<int>("").error, NumberError::InvalidSyntax);
+    EXPECT_EQ(scanNumber<int>("-").error, NumberError::InvalidSyntax);
+    EXPECT_EQ(scanNumber<int>("a1").error, NumberError::InvalidSyntax);
+    EXPECT_EQ(scanNumber<int>("2147483648").error, NumberError::Overflow);
+    EXPECT_EQ(scanNumber<int>("-2147483649").error, NumberError::Overflow);
+    EXPECT_EQ(scanNumber<float>("1e39", brigadier::NumberFormat::Exponent).error, NumberError::Overflow);
+
+    auto partial = scanNumber<int>("12ab");
+    EXPECT_TRUE(partial);
+    EXPECT_EQ(partial.value, 12);
+    EXPECT_EQ(partial.length, 2);
+
+    brigadier::StringReader reader("12ab");
+    EXPECT_EQ(brigadier::_util::scanNumber<int>(reader, brigadier::NumberFormat::Decimal).error, NumberError::TrailingGarbage);
+    EXPECT_EQ(reader.getCursor(), 0);
+}
+
+TEST(NumberScanner, decimalFormat)
+{
+    using brigadier::scanNumber;
+
+    EXPECT_EQ(scanNumber<int>("+42").value, 42);
+    EXPECT_EQ(scanNumber<long>("-9223372036854775808").value, std::numeric_limits<long>::lowest());
+    EXPECT_EQ(scanNumber<double>(".5").value, 0.5);
+    EXPECT_EQ(scanNumber<double>("+1.25").value, 1.25);
+    EXPECT_EQ(scanNumber<double>("5.").length, 1);
+    EXPECT_EQ(scanNumber<int>("0x10").length, 1);
+    EXPECT_EQ(scanNumber<int>("1_000").length, 1);
+    EXPECT_EQ(scanNumber<double>("1e3").length, 1);
+}
+
+TEST(NumberScanner, optInFormats)
+{
+    using brigadier::NumberFormat;
+    using brigadier::scanNumber;
+
+    EXPECT_EQ(scanNumber<int>("0x1F", NumberFormat::Hex).value, 31);
+    EXPECT_EQ(scanNumber<int>("-0x80000000", NumberFormat::Hex).value, std::numeric_limits<int>::lowest());
+    EXPECT_EQ(scanNumber<int>("0x80000000", NumberFormat::Hex).error, brigadier::NumberError::Overflow);
+    EXPECT_EQ(scanNumber<int>("1_000_000", NumberFormat::Underscores).value, 1000000);
+    EXPECT_EQ(scanNumber<int>("1__0", NumberFormat::Underscores).length, 1);
+    EXPECT_EQ(scanNumber<int>("0xFF_FF", NumberFormat::Hex | NumberFormat::Underscores).value, 0xFFFF);
+    EXPECT_EQ(scanNumber<double>("1.5e3", NumberFormat::Exponent).value, 1500.0);
+    EXPECT_EQ(scanNumber<double>("-2E-2", NumberFormat::Exponent).value, -0.02);
+    EXPECT_EQ(scanNumber<double>("1_0.2_5", NumberFormat::Underscores).value, 10.25);
+    EXPECT_EQ(scanNumber<double>("1e", NumberFormat::Exponent).length, 1);
+}
+
+TEST(StringReader, tryReadReportsErrorAndCursor)
+{
+    using brigadier::ErrorCode;
+    using brigadier::ParseError;
+
+    brigadier::StringViewReader reader("12 abc \"unterminated");
+
+    auto number = reader.tryReadInt();
+    ASSERT_TRUE(number);
+    EXPECT_EQ(*number, 12);
+
+    auto invalid = reader.tryReadInt();
+    ASSERT_FALSE(invalid);
+    EXPECT_EQ(invalid.error(), (ParseError {ErrorCode::ExpectedInt, 3}));
+    EXPECT_EQ(reader.getCursor(), 3);
+
+    auto boolean = reader.tryReadBool();
+    ASSERT_FALSE(boolean);
+    EXPECT_EQ(boolean.error().code, ErrorCode::InvalidBool);
+    EXPECT_EQ(reader.getCursor(), 3);
+
+    EXPECT_EQ(*reader.tryReadStringView(), "abc");
+    auto quoted = reader.tryReadStringView();
+    ASSERT_FALSE(quoted);
+    EXPECT_EQ(quoted.error().code, ErrorCode::ExpectedEndOfQuote);
+    EXPECT_EQ(reader.getCursor(), 7);
+
+    brigadier::StringReader overflow("99999999999");
+    EXPECT_EQ(overflow.tryReadInt().error().code, ErrorCode::NumberOutOfRange);
+    EXPECT_EQ(*overflow.tryReadLong(), 99999999999L);
+}
+
+TEST(StringReader, syntaxExceptionOwnsItsInput)
+{
+    auto input = std::make_unique<std::string>("give steve lots");
+    brigadier::StringViewReader reader(*input);
+    reader.setCursor(11);
+
+    try {
+        reader.readInt();
+        FAIL() << "readInt should have thrown";
+    } catch (const brigadier::CommandSyntaxException &e) {
+        input.reset();
+        EXPECT_EQ(e.getError(), (brigadier::ParseError {brigadier::ErrorCode::ExpectedInt, 11}));
+        EXPECT_EQ(e.getInput(), "give steve lots");
+        EXPECT_STREQ(e.what(), "Expected int at position 11 whilst reading give steve lots");
+    }
+
+    brigadier::CommandSyntaxException custom("Custom message");
+    EXPECT_STREQ(custom.what(), "Custom message");
+}
+
+TEST(StringViewReader, quotedStringEscapes)
+{
+    using brigadier::ErrorCode;
+
+    brigadier::StringViewReader reader(R"("a \"quoted\" \\ word" rest)");
+    EXPECT_EQ(*reader.tryReadStringView(), R"(a \"quoted\" \\ word)");
+    EXPECT_EQ(*reader.tryReadStringView(), "rest");
+
+    brigadier::StringViewReader escapedQuote(R"("\"")");
+    EXPECT_EQ(*escapedQuote.tryReadStringView(), R"(\")");
+
+    brigadier::StringViewReader escapedBackslash(R"('ab\\' c)");
+    EXPECT_EQ(*escapedBackslash.tryReadStringView(), R"(ab\\)");
+    EXPECT_EQ(escapedBackslash.getCursor(), 7);
+
+    brigadier::StringViewReader dangling(R"("abc\)");
+    EXPECT_EQ(dangling.tryReadStringView().error(), (brigadier::ParseError {ErrorCode::ExpectedEscapeSequence, 1}));
+    EXPECT_EQ(dangling.getCursor(), 0);
+
+    // Long enough for the vectorized scanners
+    auto book = std::string(100, 'x') + "\\\"" + std::string(100, 'y');
+    auto input = "\"" + book + "\"   " + std::string(70, 'z') + "   ";
+    brigadier::StringViewReader longReader(input);
+    EXPECT_EQ(*longReader.tryReadStringView(), book);
+    EXPECT_EQ(*longReader.tryReadStringView(), std::string(70, 'z'));
+    EXPECT_FALSE(longReader.canRead());
+}
+
+TEST(StringViewReader, customCharClasses)
+{
+    static constexpr auto classes = brigadier::CharClasses::standard().set(":/", brigadier::CharClasses::Unquoted).set("'", brigadier::CharClasses::Quote, false);
+
+    brigadier::StringViewReader reader("minecraft:stone 'a'");
+    EXPECT_EQ(*reader.tryReadStringView(), "minecraft");
+    EXPECT_FALSE(reader.tryReadStringView());
+
+    reader.setCursor(0);
+    reader.setCharClasses(&classes);
+    EXPECT_EQ(*reader.tryReadStringView(), "minecraft:stone");
+    EXPECT_FALSE(reader.isQuotedStringStart('\''));
+    EXPECT_EQ(reader.tryReadStringView().error().code, brigadier::ErrorCode::ExpectedString);
+
+    // Whitespace does not depend on the locale, nor on the sign of char
+    EXPECT_TRUE(reader.isSpace('\t'));
+    EXPECT_FALSE(reader.isSpace('\xA0'));
+    EXPECT_FALSE(reader.isAllowedInUnquotedString('\xE9'));
+}
+
+TEST(StringViewReader, scanLevelsAgree)
+{
+    using brigadier::ScanLevel;
+
+    auto initial = brigadier::getScanLevel();
+    auto prop = [](const std::vector<uint8_t> &picks) {
+        static constexpr std::string_view alphabet = "ab09_.+ \t\"'\\:\xE9";
+        // Runs of up to 16 times the same character, for tokens and quoted strings longer than a vector
+        std::string input;
+        for (auto pick : picks)
+            input.append((pick >> 4) + 1, alphabet[pick % alphabet.size()]);
+
+        static constexpr auto custom = brigadier::CharClasses::standard().set(":\xE9", brigadier::CharClasses::Unquoted).set("\t", brigadier::CharClasses::Space, false);
+        auto tokenize = [&input](ScanLevel level, const brigadier::CharClasses *classes) {
+            std::vector<std::string> tokens;
+            if (!brigadier::setScanLevel(level))
+                return tokens;
+            brigadier::StringViewReader reader(input);
+            reader.setCharClasses(classes);
+            while (reader.canRead()) {
+                reader.skipWhitespace();
+                auto token = reader.tryReadStringView();
+                tokens.push_back(token ? "=" + std::string(*token) : "!" + std::to_string(int(token.error().code)));
+                if (!token)
+                    reader.skip();
+            }
+            return tokens;
+        };
+
+        for (auto classes : {&brigadier::standardCharClasses, &custom}) {
+            auto scalar = tokenize(ScanLevel::Scalar, classes);
+            for (auto level : {ScanLevel::Sse2, ScanLevel::Avx2}) {
+                auto tokens = tokenize(level, classes);
+                if (!tokens.empty() || input.empty())
+                    RC_ASSERT(tokens == scalar);
+            }
+        }
+    };
+    rc::check(prop);
+    brigadier::setScanLevel(initial);
+}
+
+TEST(StringViewReader, tokens)
+{
+    brigadier::Tokens tokens;
+    std::string_view input = "give  \"a \\\" b\" 64 x:y \"open";
+    brigadier::StringViewReader reader(input);
+    reader.setTokens(&tokens);
+    ASSERT_FALSE(tokens.isLexed());
+
+    ASSERT_EQ(reader.readStringView(), "give");
+    ASSERT_TRUE(tokens.isLexed());
+    // give, the quoted string, 64, x, y and open: no token starts at ':' nor at the unterminated quote
+    ASSERT_EQ(tokens.size(), 6);
+    ASSERT_TRUE(tokens[1].quoted);
+    ASSERT_EQ(tokens[1].view(input), "a \\\" b");
+    ASSERT_EQ(tokens[4].offset, input.find('y'));
+
+    auto start = reader.getCursor();
+    ASSERT_EQ(reader.readQuotedView(), "a \\\" b");
+    reader.setCursor(start);
+    ASSERT_EQ(reader.readStringView(), "a \\\" b");
+    ASSERT_EQ(reader.readInt(), 64);
+    ASSERT_EQ(reader.readUnquotedView(), "x");
+    ASSERT_EQ(reader.peek(), ':');
+    ASSERT_EQ(reader.tryReadStringView().error().code, brigadier::ErrorCode::ExpectedString);
+    reader.skip();
+    ASSERT_EQ(reader.readStringView(), "y");
+    ASSERT_EQ(reader.tryReadStringView().error(), (brigadier::ParseError {brigadier::ErrorCode::ExpectedEndOfQuote, input.size() - 4}));
+}
+
+TEST(StringViewReader, tokensAgreeWithScanning)
+{
+    auto prop = [](const std::vector<uint8_t> &bytes) {
+        static constexpr std::string_view alphabet = "ab09_.+ \t\"'\\:";
+        // The first half builds the input, the second picks the operations
+        std::string input;
+        for (size_t i = 0; i < bytes.size() / 2; ++i)
+            input.append((bytes[i] >> 5) + 1, alphabet[bytes[i] % alphabet.size()]);
+        std::vector<uint8_t> operations(bytes.begin() + bytes.size() / 2, bytes.end());
+
+        // The same reads, moving back to an earlier cursor now and then, with and without tokens
+        auto run = [&](brigadier::Tokens *tokens) {
+            std::vector<std::string> reads;
+            std::vector<size_t> cursors {0};
+            brigadier::StringViewReader reader(input);
+            reader.setTokens(tokens);
+            for (auto operation : operations) {
+                brigadier::Result<std::string_view> read = std::string_view {};
+                switch (operation % 5) {
+                case 0:
+                    read = reader.tryReadStringView();
+                    break;
+                case 1:
+                    read = reader.tryReadUnquotedView();
+                    break;
+                case 2:
+                    read = reader.tryReadQuotedView();
+                    break;
+                case 3:
+                    if (reader.canRead())
+                        reader.skip();
+                    break;
+                default:
+                    reader.setCursor(cursors[(operation / 5) % cursors.size()]);
+                    break;
+                }
+                reads.push_back(read ? "=" + std::string(*read) : "!" + std::to_string(int(read.error().code)) + "@" + std::to_string(read.error().cursor));
+                reads.push_back(std::to_string(reader.getCursor()));
+                cursors.push_back(reader.getCursor());
+            }
+            return reads;
+        };
+
+        brigadier::Tokens tokens;
+        RC_ASSERT(run(&tokens) == run(nullptr));
+    };
+    rc::check(prop);
+}